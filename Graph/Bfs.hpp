@@ -0,0 +1,188 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Bitmap.hpp"
+#include "CsrGraph.hpp"
+#include "Parallel.hpp"
+
+// Per-vertex BFS results like GraphInfo: distance is -1 for vertices the
+// source doesn't reach, parent is -1 for those and for the source.
+struct BfsInfo {
+  std::vector<int> distance;
+  std::vector<int> parent;
+};
+
+// Beamer's switch points: go bottom-up once the frontier's out-edges exceed
+// 1/alpha of the edges left to explore, back top-down once the frontier is
+// under 1/beta of the vertices and shrinking.
+struct BfsOptions {
+  unsigned threads = DefaultThreads();
+  int alpha = 15;
+  int beta = 18;
+};
+
+namespace bfs_detail {
+// below this much work per thread a level runs on fewer threads
+constexpr std::size_t kGrain = 1 << 12;
+
+inline unsigned Workers(std::size_t work, unsigned threads) noexcept {
+  return static_cast<unsigned>(std::clamp<std::size_t>(work / kGrain, 1, std::max(threads, 1u)));
+}
+
+// concatenates the per-thread buffers into out
+inline void Gather(std::vector<std::vector<int>>& local, std::vector<int>& out, unsigned threads) {
+  std::vector<std::size_t> begin(local.size() + 1, 0);
+  for (std::size_t i = 0; i < local.size(); ++i) {
+    begin[i + 1] = begin[i] + local[i].size();
+  }
+  out.resize(begin.back());
+  auto const workers = Workers(out.size(), threads);
+  ParallelFor(local.size(), workers, [&](std::size_t first, std::size_t last, unsigned) {
+    for (auto i = first; i < last; ++i) {
+      std::ranges::copy(local[i], out.begin() + static_cast<std::ptrdiff_t>(begin[i]));
+      local[i].clear();
+    }
+  });
+}
+}  // namespace bfs_detail
+
+// Direction-optimizing parallel BFS from source. reverse must be
+// g.Transposed() (or g itself for an undirected graph): bottom-up steps
+// scan in-neighbours of unvisited vertices for one in the frontier.
+// Top-down steps claim vertices through an atomic visited bitmap and
+// collect the next frontier in per-thread buffers. Distances are exact;
+// which parent wins a race between frontier vertices is unspecified.
+inline BfsInfo Bfs(CsrGraph const& g, CsrGraph const& reverse, int source,
+                   BfsOptions const& options = {}) {
+  using namespace bfs_detail;
+  auto const n = static_cast<std::size_t>(g.VertexCount());
+  if (source < 0 || static_cast<std::size_t>(source) >= n) {
+    throw std::out_of_range("Bfs: source out of range");
+  }
+  if (reverse.VertexCount() != g.VertexCount() || reverse.EdgeCount() != g.EdgeCount()) {
+    throw std::invalid_argument("Bfs: reverse is not the transpose of g");
+  }
+  auto const threads = std::max(options.threads, 1u);
+
+  BfsInfo info{std::vector<int>(n, -1), std::vector<int>(n, -1)};
+  AtomicBitmap visited{n};
+  AtomicBitmap front{n};
+  AtomicBitmap next{n};
+  std::vector<int> queue{source};
+  std::vector<std::vector<int>> local(threads);
+  std::vector<std::size_t> localEdges(threads);
+  std::vector<std::size_t> localAwake(threads);
+
+  visited.TrySet(static_cast<std::size_t>(source));
+  info.distance[static_cast<std::size_t>(source)] = 0;
+  // out-edges of the frontier, out-edges of unvisited vertices
+  std::size_t frontierEdges = g.Degree(source);
+  std::size_t edgesLeft = g.EdgeCount() - frontierEdges;
+  std::size_t frontierSize = 1;
+  bool bottomUp = false;
+
+  for (int depth = 0; frontierSize != 0; ++depth) {
+    if (!bottomUp && frontierEdges > edgesLeft / static_cast<std::size_t>(options.alpha)) {
+      // queue -> bitmap
+      bottomUp = true;
+      front.Clear();
+      for (int v : queue) {
+        front.TrySet(static_cast<std::size_t>(v));
+      }
+    }
+
+    std::ranges::fill(localEdges, 0);
+    std::ranges::fill(localAwake, 0);
+    if (bottomUp) {
+      // threads own whole words of next and visited
+      auto const workers = Workers(n, threads);
+      ParallelFor(visited.WordCount(), workers, [&](std::size_t first, std::size_t last,
+                                                    unsigned worker) {
+        std::size_t edges = 0;
+        std::size_t awake = 0;
+        for (auto w = first; w < last; ++w) {
+          auto seen = visited.Word(w);
+          std::uint64_t found = 0;
+          auto const end = std::min(n, (w + 1) * AtomicBitmap::kWordBits);
+          for (auto v = w * AtomicBitmap::kWordBits; v < end; ++v) {
+            if (seen >> (v % AtomicBitmap::kWordBits) & 1) {
+              continue;
+            }
+            for (int u : reverse.Neighbors(static_cast<int>(v))) {
+              if (front.Test(static_cast<std::size_t>(u))) {
+                info.parent[v] = u;
+                info.distance[v] = depth + 1;
+                found |= std::uint64_t{1} << (v % AtomicBitmap::kWordBits);
+                edges += g.Degree(static_cast<int>(v));
+                ++awake;
+                break;
+              }
+            }
+          }
+          next.StoreWord(w, found);
+          visited.StoreWord(w, seen | found);
+        }
+        localEdges[worker] = edges;
+        localAwake[worker] = awake;
+      });
+      std::swap(front, next);
+    } else {
+      auto const workers = Workers(frontierEdges, threads);
+      ParallelFor(queue.size(), workers, [&](std::size_t first, std::size_t last,
+                                             unsigned worker) {
+        auto& out = local[worker];
+        std::size_t edges = 0;
+        for (auto i = first; i < last; ++i) {
+          int const u = queue[i];
+          for (int v : g.Neighbors(u)) {
+            auto const slot = static_cast<std::size_t>(v);
+            if (!visited.Test(slot) && visited.TrySet(slot)) {
+              info.parent[slot] = u;
+              info.distance[slot] = depth + 1;
+              out.push_back(v);
+              edges += g.Degree(v);
+            }
+          }
+        }
+        localEdges[worker] = edges;
+        localAwake[worker] = out.size();
+      });
+    }
+
+    auto const previousSize = frontierSize;
+    frontierEdges = 0;
+    frontierSize = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+      frontierEdges += localEdges[t];
+      frontierSize += localAwake[t];
+    }
+    edgesLeft -= std::min(edgesLeft, frontierEdges);
+
+    if (!bottomUp) {
+      Gather(local, queue, threads);
+    } else if (frontierSize < previousSize &&
+               frontierSize < n / static_cast<std::size_t>(options.beta)) {
+      // bitmap -> queue
+      bottomUp = false;
+      queue.clear();
+      for (std::size_t w = 0; w < front.WordCount(); ++w) {
+        for (auto bits = front.Word(w); bits != 0; bits &= bits - 1) {
+          queue.push_back(static_cast<int>(w * AtomicBitmap::kWordBits +
+                                           static_cast<std::size_t>(std::countr_zero(bits))));
+        }
+      }
+    }
+  }
+  return info;
+}
+
+// undirected graphs (every edge stored both ways) are their own transpose
+inline BfsInfo BfsUndirected(CsrGraph const& g, int source, BfsOptions const& options = {}) {
+  return Bfs(g, g, source, options);
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One bit per vertex in atomic words. TrySet is the only read-modify-write;
+// Set/Reset on words owned by one thread can use the plain store variants.
+class AtomicBitmap {
+ public:
+  static constexpr std::size_t kWordBits = 64;
+
+  AtomicBitmap() = default;
+
+  explicit AtomicBitmap(std::size_t size)
+      : m_words((size + kWordBits - 1) / kWordBits), m_size(size) {
+  }
+
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return m_size;
+  }
+
+  [[nodiscard]] std::size_t WordCount() const noexcept {
+    return m_words.size();
+  }
+
+  [[nodiscard]] bool Test(std::size_t i) const noexcept {
+    return (Word(i / kWordBits) >> (i % kWordBits) & 1) != 0;
+  }
+
+  // true if this call flipped the bit
+  bool TrySet(std::size_t i) noexcept {
+    auto const mask = std::uint64_t{1} << (i % kWordBits);
+    return (m_words[i / kWordBits].fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+  }
+
+  [[nodiscard]] std::uint64_t Word(std::size_t w) const noexcept {
+    return m_words[w].load(std::memory_order_relaxed);
+  }
+
+  // not atomic against other writers of word w
+  void StoreWord(std::size_t w, std::uint64_t bits) noexcept {
+    m_words[w].store(bits, std::memory_order_relaxed);
+  }
+
+  // single-threaded
+  void Clear() noexcept {
+    for (auto& word : m_words) {
+      word.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] std::size_t Count() const noexcept {
+    std::size_t count = 0;
+    for (auto const& word : m_words) {
+      count += static_cast<std::size_t>(std::popcount(word.load(std::memory_order_relaxed)));
+    }
+    return count;
+  }
+
+ private:
+  std::vector<std::atomic<std::uint64_t>> m_words;
+  std::size_t m_size = 0;
+};
@@ -0,0 +1,193 @@
+#pragma once
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Parallel.hpp"
+
+// directed edge from -> to
+struct Edge {
+  int from;
+  int to;
+};
+
+// Immutable compressed sparse row graph: the targets of v are
+// Targets()[Offsets()[v] .. Offsets()[v + 1]), in the order the edges came in,
+// so traversals visit neighbours exactly like the push_back built lists.
+class CsrGraph {
+ public:
+  CsrGraph() = default;
+
+  // offsets has VertexCount() + 1 entries, front 0 and back targets.size()
+  CsrGraph(std::vector<std::size_t> offsets, std::vector<int> targets)
+      : m_offsets(std::move(offsets)), m_targets(std::move(targets)) {
+    if (m_offsets.empty() || m_offsets.front() != 0 || m_offsets.back() != m_targets.size()) {
+      throw std::invalid_argument("CsrGraph: offsets don't match targets");
+    }
+  }
+
+  // Parallel stable counting sort. Vertices are split in one range per
+  // thread; edges are first bucketed by range (each thread its own chunk),
+  // then every range is counted and scattered on its own. Throws
+  // std::out_of_range for an endpoint outside [0, vertexCount).
+  [[nodiscard]] static CsrGraph FromEdges(std::span<Edge const> edges, int vertexCount,
+                                          unsigned threads = DefaultThreads()) {
+    if (vertexCount < 0) {
+      throw std::out_of_range("CsrGraph: negative vertex count");
+    }
+    auto const vertices = static_cast<std::size_t>(vertexCount);
+    // small inputs aren't worth the threads
+    constexpr std::size_t kEdgesPerThread = 1 << 16;
+    auto const workers = static_cast<unsigned>(std::max<std::size_t>(
+        1, std::min<std::size_t>({threads, edges.size() / kEdgesPerThread,
+                                  std::max<std::size_t>(vertices, 1)})));
+    auto const rangeSize = (vertices + workers - 1) / workers;
+    auto const range = [rangeSize](int v) { return static_cast<std::size_t>(v) / rangeSize; };
+
+    // counts[worker * workers + range], then the start of that slice in staged
+    std::vector<std::size_t> counts(std::size_t{workers} * workers, 0);
+    std::atomic<bool> invalid{false};
+    ParallelFor(edges.size(), workers, [&](std::size_t begin, std::size_t end, unsigned worker) {
+      auto const local = counts.data() + std::size_t{worker} * workers;
+      for (auto const& edge : edges.subspan(begin, end - begin)) {
+        if (edge.from < 0 || edge.from >= vertexCount || edge.to < 0 || edge.to >= vertexCount) {
+          invalid.store(true, std::memory_order_relaxed);
+          return;
+        }
+        ++local[range(edge.from)];
+      }
+    });
+    if (invalid.load(std::memory_order_relaxed)) {
+      throw std::out_of_range("CsrGraph: edge endpoint out of range");
+    }
+
+    // range-major, worker-minor: staged keeps input order inside a range
+    std::vector<std::size_t> rangeBegin(workers + 1, 0);
+    std::size_t total = 0;
+    for (unsigned r = 0; r < workers; ++r) {
+      rangeBegin[r] = total;
+      for (unsigned w = 0; w < workers; ++w) {
+        total = std::exchange(counts[std::size_t{w} * workers + r], total) + total;
+      }
+    }
+    rangeBegin[workers] = total;
+
+    std::vector<Edge> staged(workers == 1 ? 0 : edges.size());
+    if (workers != 1) {
+      ParallelFor(edges.size(), workers, [&](std::size_t begin, std::size_t end, unsigned worker) {
+        auto const cursor = counts.data() + std::size_t{worker} * workers;
+        for (auto const& edge : edges.subspan(begin, end - begin)) {
+          staged[cursor[range(edge.from)]++] = edge;
+        }
+      });
+    }
+    std::span<Edge const> const sorted = workers == 1 ? edges : std::span<Edge const>{staged};
+
+    // a range's edges land at the same place in targets as in staged
+    std::vector<std::size_t> offsets(vertices + 1, 0);
+    std::vector<int> targets(edges.size());
+    ParallelFor(workers, workers, [&](std::size_t begin, std::size_t end, unsigned) {
+      for (auto r = begin; r < end; ++r) {
+        auto const first = std::min(vertices, r * rangeSize);
+        auto const last = std::min(vertices, first + rangeSize);
+        auto const slice = sorted.subspan(rangeBegin[r], rangeBegin[r + 1] - rangeBegin[r]);
+        for (auto const& edge : slice) {
+          ++offsets[static_cast<std::size_t>(edge.from) + 1];
+        }
+        auto running = rangeBegin[r];
+        for (auto v = first; v < last; ++v) {
+          running = std::exchange(offsets[v + 1], running) + running;
+        }
+        // offsets[v + 1] is v's cursor now and ends up at its end
+        for (auto const& edge : slice) {
+          targets[offsets[static_cast<std::size_t>(edge.from) + 1]++] = edge.to;
+        }
+      }
+    });
+    return CsrGraph{std::move(offsets), std::move(targets)};
+  }
+
+  [[nodiscard]] static CsrGraph FromAdjacency(std::vector<std::vector<int>> const& g) {
+    std::vector<std::size_t> offsets(g.size() + 1, 0);
+    for (std::size_t v = 0; v < g.size(); ++v) {
+      offsets[v + 1] = offsets[v] + g[v].size();
+    }
+    std::vector<int> targets;
+    targets.reserve(offsets.back());
+    for (auto const& neighbors : g) {
+      targets.insert(targets.end(), neighbors.begin(), neighbors.end());
+    }
+    return CsrGraph{std::move(offsets), std::move(targets)};
+  }
+
+  // every edge reversed, in-neighbours in increasing source order
+  [[nodiscard]] CsrGraph Transposed(unsigned threads = DefaultThreads()) const {
+    std::vector<Edge> reversed(m_targets.size());
+    ParallelFor(m_offsets.size() - 1, threads, [&](std::size_t begin, std::size_t end, unsigned) {
+      for (auto v = begin; v < end; ++v) {
+        for (auto e = m_offsets[v]; e < m_offsets[v + 1]; ++e) {
+          reversed[e] = {m_targets[e], static_cast<int>(v)};
+        }
+      }
+    });
+    return FromEdges(reversed, VertexCount(), threads);
+  }
+
+  [[nodiscard]] int VertexCount() const noexcept {
+    return static_cast<int>(m_offsets.size() - 1);
+  }
+
+  [[nodiscard]] std::size_t EdgeCount() const noexcept {
+    return m_targets.size();
+  }
+
+  [[nodiscard]] std::span<int const> Neighbors(int v) const noexcept {
+    auto const begin = m_offsets[static_cast<std::size_t>(v)];
+    return {m_targets.data() + begin, m_offsets[static_cast<std::size_t>(v) + 1] - begin};
+  }
+
+  [[nodiscard]] std::size_t Degree(int v) const noexcept {
+    return m_offsets[static_cast<std::size_t>(v) + 1] - m_offsets[static_cast<std::size_t>(v)];
+  }
+
+  [[nodiscard]] std::span<std::size_t const> Offsets() const noexcept {
+    return m_offsets;
+  }
+
+  [[nodiscard]] std::span<int const> Targets() const noexcept {
+    return m_targets;
+  }
+
+ private:
+  std::vector<std::size_t> m_offsets{0};
+  std::vector<int> m_targets;
+};
+
+// Algorithms take any layout through these two functions.
+inline int VertexCount(std::vector<std::vector<int>> const& g) noexcept {
+  return static_cast<int>(g.size());
+}
+
+inline std::span<int const> Neighbors(std::vector<std::vector<int>> const& g, int v) noexcept {
+  return g[static_cast<std::size_t>(v)];
+}
+
+inline int VertexCount(CsrGraph const& g) noexcept {
+  return g.VertexCount();
+}
+
+inline std::span<int const> Neighbors(CsrGraph const& g, int v) noexcept {
+  return g.Neighbors(v);
+}
+
+template <typename G>
+concept AdjacencyGraph = requires(G const& g, int v) {
+  { VertexCount(g) } -> std::convertible_to<int>;
+  { Neighbors(g, v) } -> std::ranges::input_range;
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "DfsWorkspace.hpp"
+
+// Everything here reads the DFS timestamps of a DfsForest.
+
+enum class EdgeKind : std::uint8_t { tree, forward, back, cross };
+
+// kind of the edge u -> v once the forest covers both ends; a parallel
+// edge to a child counts as tree, a self-loop as back
+[[nodiscard]] inline EdgeKind ClassifyEdge(DfsForest const& forest, int u, int v) noexcept {
+  if (IsAncestor(forest, v, u)) {
+    return EdgeKind::back;
+  }
+  if (IsAncestor(forest, u, v)) {
+    return forest.parent[v] == u ? EdgeKind::tree : EdgeKind::forward;
+  }
+  return EdgeKind::cross;
+}
+
+// Vertices of some directed cycle in edge order (the last one has an edge
+// back to the first), empty if g is acyclic. Uses the workspace's forest:
+// a back edge u -> v closes the tree path v .. u.
+template <AdjacencyGraph Graph>
+[[nodiscard]] std::vector<int> FindCycle(Graph const& g, DfsWorkspace& workspace) {
+  auto const forest = workspace.VisitAll(g);
+  for (int u = 0, n = VertexCount(g); u < n; ++u) {
+    for (int v : Neighbors(g, u)) {
+      if (ClassifyEdge(forest, u, v) == EdgeKind::back) {
+        std::vector<int> cycle;
+        for (int w = u; w != v; w = forest.parent[w]) {
+          cycle.push_back(w);
+        }
+        cycle.push_back(v);
+        std::ranges::reverse(cycle);
+        return cycle;
+      }
+    }
+  }
+  return {};
+}
+
+template <AdjacencyGraph Graph>
+[[nodiscard]] std::vector<int> FindCycle(Graph const& g) {
+  DfsWorkspace workspace{VertexCount(g)};
+  return FindCycle(g, workspace);
+}
+
+// Vertices by decreasing tOut, so every edge goes forward; nullopt if g has
+// a cycle (some edge doesn't go to a smaller tOut).
+template <AdjacencyGraph Graph>
+[[nodiscard]] std::optional<std::vector<int>> TopologicalOrder(Graph const& g,
+                                                               DfsWorkspace& workspace) {
+  auto const forest = workspace.VisitAll(g);
+  auto const n = VertexCount(g);
+  for (int u = 0; u < n; ++u) {
+    for (int v : Neighbors(g, u)) {
+      if (forest.tOut[v] >= forest.tOut[u]) {
+        return std::nullopt;
+      }
+    }
+  }
+  // tOut values are distinct and below 2n
+  std::vector<int> byTime(2 * static_cast<std::size_t>(n), -1);
+  for (int v = 0; v < n; ++v) {
+    byTime[static_cast<std::size_t>(forest.tOut[v])] = v;
+  }
+  std::vector<int> order;
+  order.reserve(static_cast<std::size_t>(n));
+  for (auto it = byTime.rbegin(); it != byTime.rend(); ++it) {
+    if (*it != -1) {
+      order.push_back(*it);
+    }
+  }
+  return order;
+}
+
+template <AdjacencyGraph Graph>
+[[nodiscard]] std::optional<std::vector<int>> TopologicalOrder(Graph const& g) {
+  DfsWorkspace workspace{VertexCount(g)};
+  return TopologicalOrder(g, workspace);
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "GraphInfo.hpp"
+
+// DFS forest of the vertices visited since the last Reset: parent is -1 for
+// roots, tIn/tOut come from one timer across all trees. Views into the
+// workspace, valid until its next Reset or Visit.
+struct DfsForest {
+  std::span<int const> roots;
+  std::span<int const> parent;
+  std::span<int const> tIn;
+  std::span<int const> tOut;
+};
+
+// u is v or one of its ancestors in the forest
+[[nodiscard]] inline bool IsAncestor(DfsForest const& forest, int u, int v) noexcept {
+  return forest.tIn[u] <= forest.tIn[v] && forest.tOut[v] <= forest.tOut[u];
+}
+
+// Dfs state sized once for a vertex count and reused across traversals.
+// Reset is O(1): a vertex counts as white unless its stamp matches the
+// current epoch, so colors are never refilled. Entries of vertices not
+// visited in the current epoch are stale. Once sized, Reset/Visit/VisitAll
+// don't allocate (the frame stack and roots keep their capacity).
+class DfsWorkspace {
+ public:
+  DfsWorkspace() = default;
+
+  explicit DfsWorkspace(int vertexCount) {
+    Resize(vertexCount);
+  }
+
+  // allocates when growing, starts a new epoch
+  void Resize(int vertexCount) {
+    auto const vertices = static_cast<std::size_t>(vertexCount);
+    m_stamp.assign(vertices, 0);
+    m_epoch = 0;
+    m_color.resize(vertices);
+    m_parent.resize(vertices);
+    m_tIn.resize(vertices);
+    m_tOut.resize(vertices);
+    m_stack.reserve(vertices);
+    m_roots.reserve(vertices);
+    Reset();
+  }
+
+  // forgets every visit
+  void Reset() noexcept {
+    if (++m_epoch == 0) {
+      std::ranges::fill(m_stamp, 0u);
+      m_epoch = 1;
+    }
+    m_timer = 0;
+    m_roots.clear();
+  }
+
+  [[nodiscard]] int VertexCount() const noexcept {
+    return static_cast<int>(m_stamp.size());
+  }
+
+  [[nodiscard]] Color ColorOf(int v) const noexcept {
+    auto const i = static_cast<std::size_t>(v);
+    return m_stamp[i] == m_epoch ? m_color[i] : Color::white;
+  }
+
+  [[nodiscard]] bool Visited(int v) const noexcept {
+    return m_stamp[static_cast<std::size_t>(v)] == m_epoch;
+  }
+
+  [[nodiscard]] int Timer() const noexcept {
+    return m_timer;
+  }
+
+  // Dfs from root if it's still white, adding a tree to the forest
+  template <AdjacencyGraph Graph>
+  void Visit(Graph const& g, int root) {
+    if (Visited(root)) {
+      return;
+    }
+    m_roots.push_back(root);
+    Enter(root, -1);
+    while (!m_stack.empty()) {
+      auto& frame = m_stack.back();
+      auto const neighbors = Neighbors(g, frame.vertex);
+      while (frame.next < neighbors.size() && Visited(neighbors[frame.next])) {
+        ++frame.next;
+      }
+      if (frame.next == neighbors.size()) {
+        Leave(frame.vertex);
+        continue;
+      }
+      int const to = neighbors[frame.next++];
+      // invalidates frame
+      Enter(to, frame.vertex);
+    }
+  }
+
+  // Visit from each source in order; sources already reached are skipped
+  template <AdjacencyGraph Graph>
+  DfsForest VisitFrom(Graph const& g, std::span<int const> sources) {
+    for (int source : sources) {
+      Visit(g, source);
+    }
+    return Forest();
+  }
+
+  // Reset, then Visit every vertex in index order: covers all components
+  template <AdjacencyGraph Graph>
+  DfsForest VisitAll(Graph const& g) {
+    Reset();
+    for (int v = 0, n = VertexCount(); v < n; ++v) {
+      Visit(g, v);
+    }
+    return Forest();
+  }
+
+  [[nodiscard]] DfsForest Forest() const noexcept {
+    return {m_roots, m_parent, m_tIn, m_tOut};
+  }
+
+ private:
+  void Enter(int v, int parent) {
+    auto const i = static_cast<std::size_t>(v);
+    m_stamp[i] = m_epoch;
+    m_color[i] = Color::grey;
+    m_parent[i] = parent;
+    m_tIn[i] = m_timer++;
+    m_stack.push_back({v, 0});
+  }
+
+  void Leave(int v) noexcept {
+    auto const i = static_cast<std::size_t>(v);
+    m_color[i] = Color::black;
+    m_tOut[i] = m_timer++;
+    m_stack.pop_back();
+  }
+
+ private:
+  std::vector<std::uint32_t> m_stamp;
+  std::uint32_t m_epoch = 0;
+  std::vector<Color> m_color;
+  std::vector<int> m_parent;
+  std::vector<int> m_tIn;
+  std::vector<int> m_tOut;
+  int m_timer = 0;
+  std::vector<DfsFrame> m_stack;
+  std::vector<int> m_roots;
+};
@@ -0,0 +1,291 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "CsrGraph.hpp"
+
+namespace dynamic_graph_detail {
+inline constexpr int kTombstone = -1;
+inline constexpr std::size_t kBlockSlots = 14;
+
+// one cache line of targets
+struct alignas(64) Block {
+  std::array<int, kBlockSlots> targets;
+  int used = 0;
+  int next = -1;
+};
+
+// a chain of blocks, appended to at the tail
+struct List {
+  int head = -1;
+  int tail = -1;
+  int live = 0;
+  int dead = 0;
+};
+}  // namespace dynamic_graph_detail
+
+// Mutable directed multigraph over a fixed vertex set. Each vertex has a
+// chain of 64-byte blocks of out-targets and one of in-sources, all in a
+// shared pool. Insertion appends to the tail block; removal leaves a
+// tombstone. A list is compacted in place once its tombstones reach a
+// block and outnumber its live edges, so updates stay amortized O(1) plus
+// the scan for the removed edge. In-lists are kept for incremental
+// algorithms that have to look backwards.
+class DynamicGraph {
+ public:
+  explicit DynamicGraph(int vertexCount = 0) {
+    if (vertexCount < 0) {
+      throw std::out_of_range("DynamicGraph: negative vertex count");
+    }
+    m_out.resize(static_cast<std::size_t>(vertexCount));
+    m_in.resize(static_cast<std::size_t>(vertexCount));
+  }
+
+  explicit DynamicGraph(CsrGraph const& g) : DynamicGraph(g.VertexCount()) {
+    for (int v = 0; v < g.VertexCount(); ++v) {
+      for (int w : g.Neighbors(v)) {
+        Insert(v, w);
+      }
+    }
+  }
+
+  [[nodiscard]] int VertexCount() const noexcept {
+    return static_cast<int>(m_out.size());
+  }
+
+  // live edges
+  [[nodiscard]] std::size_t EdgeCount() const noexcept {
+    return m_edges;
+  }
+
+  [[nodiscard]] std::size_t TombstoneCount() const noexcept {
+    return m_tombstones;
+  }
+
+  [[nodiscard]] std::size_t Degree(int v) const noexcept {
+    return static_cast<std::size_t>(m_out[static_cast<std::size_t>(v)].live);
+  }
+
+  [[nodiscard]] std::size_t InDegree(int v) const noexcept {
+    return static_cast<std::size_t>(m_in[static_cast<std::size_t>(v)].live);
+  }
+
+  void AddEdge(int from, int to) {
+    Check(from, to);
+    Insert(from, to);
+  }
+
+  // removes one from -> to, false if there is none
+  bool RemoveEdge(int from, int to) {
+    Check(from, to);
+    if (!Remove(m_out[static_cast<std::size_t>(from)], to)) {
+      return false;
+    }
+    Remove(m_in[static_cast<std::size_t>(to)], from);
+    --m_edges;
+    return true;
+  }
+
+  // Deletions first, then insertions, so a batch can move an edge.
+  // Deleting a missing edge is a no-op. Ids are checked up front: a bad
+  // batch throws without changing the graph.
+  void Apply(std::span<Edge const> insertions, std::span<Edge const> deletions) {
+    for (auto const& edge : deletions) {
+      Check(edge.from, edge.to);
+    }
+    for (auto const& edge : insertions) {
+      Check(edge.from, edge.to);
+    }
+    for (auto const& edge : deletions) {
+      RemoveEdge(edge.from, edge.to);
+    }
+    for (auto const& edge : insertions) {
+      Insert(edge.from, edge.to);
+    }
+  }
+
+  [[nodiscard]] bool HasEdge(int from, int to) const noexcept {
+    // the shorter of the two lists
+    auto const& out = m_out[static_cast<std::size_t>(from)];
+    auto const& in = m_in[static_cast<std::size_t>(to)];
+    bool found = false;
+    if (out.live + out.dead <= in.live + in.dead) {
+      ForEach(out, [&](int w) { found = found || w == to; });
+    } else {
+      ForEach(in, [&](int u) { found = found || u == from; });
+    }
+    return found;
+  }
+
+  // fn(w) for every live v -> w, in insertion order
+  template <typename Fn>
+  void ForEachNeighbor(int v, Fn&& fn) const {
+    ForEach(m_out[static_cast<std::size_t>(v)], fn);
+  }
+
+  // fn(u) for every live u -> v
+  template <typename Fn>
+  void ForEachInNeighbor(int v, Fn&& fn) const {
+    ForEach(m_in[static_cast<std::size_t>(v)], fn);
+  }
+
+  // drops every tombstone and returns the emptied blocks to the pool
+  void Compact() {
+    for (auto* lists : {&m_out, &m_in}) {
+      for (auto& list : *lists) {
+        if (list.dead != 0) {
+          CompactList(list);
+        }
+      }
+    }
+  }
+
+  // snapshot for the static algorithms, neighbours in insertion order
+  [[nodiscard]] CsrGraph ToCsrGraph() const {
+    auto const n = m_out.size();
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t v = 0; v < n; ++v) {
+      offsets[v + 1] = offsets[v] + static_cast<std::size_t>(m_out[v].live);
+    }
+    std::vector<int> targets;
+    targets.reserve(offsets.back());
+    for (std::size_t v = 0; v < n; ++v) {
+      ForEach(m_out[v], [&](int w) { targets.push_back(w); });
+    }
+    return CsrGraph{std::move(offsets), std::move(targets)};
+  }
+
+ private:
+  using Block = dynamic_graph_detail::Block;
+  using List = dynamic_graph_detail::List;
+
+  void Check(int from, int to) const {
+    if (from < 0 || from >= VertexCount() || to < 0 || to >= VertexCount()) {
+      throw std::out_of_range("DynamicGraph: edge endpoint out of range");
+    }
+  }
+
+  void Insert(int from, int to) {
+    Append(m_out[static_cast<std::size_t>(from)], to);
+    Append(m_in[static_cast<std::size_t>(to)], from);
+    ++m_edges;
+  }
+
+  template <typename Fn>
+  void ForEach(List const& list, Fn&& fn) const {
+    for (auto b = list.head; b != -1; b = m_blocks[static_cast<std::size_t>(b)].next) {
+      auto const& block = m_blocks[static_cast<std::size_t>(b)];
+      for (int i = 0; i < block.used; ++i) {
+        if (block.targets[static_cast<std::size_t>(i)] != dynamic_graph_detail::kTombstone) {
+          fn(block.targets[static_cast<std::size_t>(i)]);
+        }
+      }
+    }
+  }
+
+  int Allocate() {
+    if (m_free == -1) {
+      m_blocks.emplace_back();
+      return static_cast<int>(m_blocks.size() - 1);
+    }
+    auto const b = m_free;
+    auto& block = m_blocks[static_cast<std::size_t>(b)];
+    m_free = block.next;
+    block.used = 0;
+    block.next = -1;
+    return b;
+  }
+
+  // returns the chain starting at b to the pool
+  void Release(int b) {
+    while (b != -1) {
+      auto const next = m_blocks[static_cast<std::size_t>(b)].next;
+      m_blocks[static_cast<std::size_t>(b)].next = m_free;
+      m_free = b;
+      b = next;
+    }
+  }
+
+  void Append(List& list, int target) {
+    if (list.tail == -1 ||
+        m_blocks[static_cast<std::size_t>(list.tail)].used == static_cast<int>(kSlots)) {
+      auto const b = Allocate();
+      if (list.tail == -1) {
+        list.head = b;
+      } else {
+        m_blocks[static_cast<std::size_t>(list.tail)].next = b;
+      }
+      list.tail = b;
+    }
+    auto& block = m_blocks[static_cast<std::size_t>(list.tail)];
+    block.targets[static_cast<std::size_t>(block.used++)] = target;
+    ++list.live;
+  }
+
+  bool Remove(List& list, int target) {
+    for (auto b = list.head; b != -1; b = m_blocks[static_cast<std::size_t>(b)].next) {
+      auto& block = m_blocks[static_cast<std::size_t>(b)];
+      for (int i = 0; i < block.used; ++i) {
+        if (block.targets[static_cast<std::size_t>(i)] == target) {
+          block.targets[static_cast<std::size_t>(i)] = dynamic_graph_detail::kTombstone;
+          --list.live;
+          ++list.dead;
+          ++m_tombstones;
+          if (list.dead >= static_cast<int>(kSlots) && list.dead > list.live) {
+            CompactList(list);
+          }
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Slides the live targets to the front of the chain, the writer never
+  // passing the reader, and frees the blocks behind the last one written.
+  void CompactList(List& list) {
+    m_tombstones -= static_cast<std::size_t>(list.dead);
+    list.dead = 0;
+    if (list.live == 0) {
+      Release(list.head);
+      list.head = list.tail = -1;
+      return;
+    }
+    auto write = list.head;
+    std::size_t slot = 0;
+    for (auto b = list.head; b != -1; b = m_blocks[static_cast<std::size_t>(b)].next) {
+      auto const& block = m_blocks[static_cast<std::size_t>(b)];
+      for (int i = 0; i < block.used; ++i) {
+        auto const target = block.targets[static_cast<std::size_t>(i)];
+        if (target == dynamic_graph_detail::kTombstone) {
+          continue;
+        }
+        if (slot == kSlots) {
+          m_blocks[static_cast<std::size_t>(write)].used = static_cast<int>(kSlots);
+          write = m_blocks[static_cast<std::size_t>(write)].next;
+          slot = 0;
+        }
+        m_blocks[static_cast<std::size_t>(write)].targets[slot++] = target;
+      }
+    }
+    auto& last = m_blocks[static_cast<std::size_t>(write)];
+    last.used = static_cast<int>(slot);
+    Release(last.next);
+    last.next = -1;
+    list.tail = write;
+  }
+
+ private:
+  static constexpr std::size_t kSlots = dynamic_graph_detail::kBlockSlots;
+
+  std::vector<Block> m_blocks;
+  // free blocks, chained through next
+  int m_free = -1;
+  std::vector<List> m_out;
+  std::vector<List> m_in;
+  std::size_t m_edges = 0;
+  std::size_t m_tombstones = 0;
+};
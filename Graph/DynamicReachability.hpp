@@ -0,0 +1,155 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "DynamicGraph.hpp"
+
+// What a root reaches in a DynamicGraph, with a parent tree, kept up to
+// date batch by batch instead of searched again from scratch.
+//
+// After a batch only the affected part is searched again:
+//  - a deleted tree edge u -> v (the last copy of it) cuts off v's
+//    subtree. The subtree is unmarked, every vertex of it with a reached
+//    in-neighbour outside is hung back on, and a search from those finds
+//    the rest of it that is still reachable;
+//  - an inserted u -> v with u reached and v not starts a search at v.
+// Work is proportional to the edges of the cut-off subtrees and of the
+// newly reached vertices, not to the graph.
+//
+// Searches are breadth-first. A DFS tree of a big graph is one long path,
+// so almost any deleted tree edge would cut off most of it; BFS trees are
+// shallow. Parents therefore form a valid tree of reached vertices (every
+// parent edge exists, every chain ends at the root) but need not be the
+// tree Dfs from scratch would give.
+class DynamicReachability {
+ public:
+  DynamicReachability(DynamicGraph const& g, int root) : m_g(g), m_root(root) {
+    if (root < 0 || root >= g.VertexCount()) {
+      throw std::out_of_range("DynamicReachability: root out of range");
+    }
+    Recompute();
+  }
+
+  [[nodiscard]] int Root() const noexcept {
+    return m_root;
+  }
+
+  [[nodiscard]] bool Reached(int v) const noexcept {
+    return m_reached[static_cast<std::size_t>(v)] != 0;
+  }
+
+  // -1 for the root and unreached vertices
+  [[nodiscard]] int Parent(int v) const noexcept {
+    return m_parent[static_cast<std::size_t>(v)];
+  }
+
+  [[nodiscard]] std::span<int const> Parents() const noexcept {
+    return m_parent;
+  }
+
+  [[nodiscard]] int ReachedCount() const noexcept {
+    return m_reachedCount;
+  }
+
+  // vertices unmarked by the last Update, for tuning batch sizes
+  [[nodiscard]] std::size_t LastCutOff() const noexcept {
+    return m_cutOff.size();
+  }
+
+  // full search from the root
+  void Recompute() {
+    auto const n = static_cast<std::size_t>(m_g.VertexCount());
+    m_reached.assign(n, 0);
+    m_parent.assign(n, -1);
+    m_reachedCount = 0;
+    m_cutOff.clear();
+    m_queue.clear();
+    Reach(m_root, -1);
+    Search();
+  }
+
+  // Call after the same batch went into the graph, e.g. g.Apply(insertions,
+  // deletions).
+  void Update(std::span<Edge const> insertions, std::span<Edge const> deletions) {
+    m_cutOff.clear();
+    for (auto const& [u, v] : deletions) {
+      if (Reached(v) && Parent(v) == u && !m_g.HasEdge(u, v)) {
+        CutOff(v);
+      }
+    }
+    m_queue.clear();
+    // cut-off vertices hung back on by now can carry others
+    for (int v : m_cutOff) {
+      if (Reached(v)) {
+        continue;
+      }
+      m_g.ForEachInNeighbor(v, [&](int u) {
+        if (!Reached(v) && Reached(u)) {
+          Reach(v, u);
+        }
+      });
+    }
+    for (auto const& [u, v] : insertions) {
+      if (Reached(u) && !Reached(v)) {
+        Reach(v, u);
+      }
+    }
+    Search();
+  }
+
+ private:
+  void Reach(int v, int parent) {
+    m_reached[static_cast<std::size_t>(v)] = 1;
+    m_parent[static_cast<std::size_t>(v)] = parent;
+    ++m_reachedCount;
+    m_queue.push_back(v);
+  }
+
+  // breadth-first from everything in m_queue
+  void Search() {
+    for (std::size_t head = 0; head < m_queue.size(); ++head) {
+      auto const u = m_queue[head];
+      m_g.ForEachNeighbor(u, [&](int w) {
+        if (!Reached(w)) {
+          Reach(w, u);
+        }
+      });
+    }
+    m_queue.clear();
+  }
+
+  // Unmarks v's subtree. Children are the out-neighbours whose parent is
+  // the vertex, so no child lists are needed.
+  void CutOff(int v) {
+    auto const first = m_cutOff.size();
+    Unreach(v);
+    for (auto i = first; i < m_cutOff.size(); ++i) {
+      auto const u = m_cutOff[i];
+      m_g.ForEachNeighbor(u, [&](int w) {
+        if (Reached(w) && Parent(w) == u) {
+          Unreach(w);
+        }
+      });
+    }
+  }
+
+  void Unreach(int v) {
+    m_reached[static_cast<std::size_t>(v)] = 0;
+    m_parent[static_cast<std::size_t>(v)] = -1;
+    --m_reachedCount;
+    m_cutOff.push_back(v);
+  }
+
+ private:
+  DynamicGraph const& m_g;
+  int m_root;
+  std::vector<std::uint8_t> m_reached;
+  std::vector<int> m_parent;
+  int m_reachedCount = 0;
+  // reused between updates
+  std::vector<int> m_cutOff;
+  std::vector<int> m_queue;
+};
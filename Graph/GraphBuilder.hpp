@@ -0,0 +1,288 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "CsrGraph.hpp"
+#include "Parallel.hpp"
+
+struct BuildOptions {
+  unsigned threads = DefaultThreads();
+  bool dropSelfLoops = false;
+  // keeps the first u -> v of each pair, neighbour order otherwise intact
+  bool deduplicate = false;
+  // 0: largest id seen + 1
+  int vertexCount = 0;
+};
+
+namespace graph_builder_detail {
+inline constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+
+// Leading decimal digits of the next 8 bytes, with no per-byte branch:
+// bytes minus '0' above 9 mark the end. Reads 8 bytes, callers make sure
+// they exist.
+inline std::size_t DigitCount(std::uint64_t digits) noexcept {
+  auto const low7 = digits & (kOnes * 0x7F);
+  auto const stop = ((low7 + kOnes * 0x76) | digits) & (kOnes * 0x80);
+  return stop == 0 ? 8 : static_cast<std::size_t>(std::countr_zero(stop)) / 8;
+}
+
+// value of the first count (1..8) of 8 digits in memory order
+inline std::uint32_t DigitsValue(std::uint64_t digits, std::size_t count) noexcept {
+  // the first digit to the top byte, zeros (as leading digits) below
+  auto value = digits << (8 * (8 - count));
+  value = (value * 10 + (value >> 8)) & 0x00FF00FF00FF00FFull;
+  value = (value * 100 + (value >> 16)) & 0x0000FFFF0000FFFFull;
+  return static_cast<std::uint32_t>(value * 10000 + (value >> 32));
+}
+
+// Parses a non-negative int at p, 8 digits a step while 8 bytes remain;
+// false on no digit or overflow.
+inline bool ParseVertex(char const*& p, char const* end, int& out) noexcept {
+  std::uint64_t value = 0;
+  auto const begin = p;
+  while (end - p >= 8) {
+    std::uint64_t word;
+    std::memcpy(&word, p, 8);
+    auto const digits = word ^ (kOnes * '0');
+    auto const count = DigitCount(digits);
+    if (count == 0) {
+      break;
+    }
+    constexpr std::uint64_t kPowers[] = {1,      10,      100,      1000,     10000,
+                                         100000, 1000000, 10000000, 100000000};
+    value = value * kPowers[count] + DigitsValue(digits, count);
+    p += count;
+    if (value > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+      return false;
+    }
+    if (count < 8) {
+      out = static_cast<int>(value);
+      return true;
+    }
+  }
+  for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+    value = value * 10 + static_cast<std::uint64_t>(*p - '0');
+    if (value > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+      return false;
+    }
+  }
+  out = static_cast<int>(value);
+  return p != begin;
+}
+
+inline void SkipBlanks(char const*& p, char const* end) noexcept {
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+    ++p;
+  }
+}
+
+inline void SkipLine(char const*& p, char const* end) noexcept {
+  auto const eol =
+      static_cast<char const*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+  p = eol == nullptr ? end : eol + 1;
+}
+}  // namespace graph_builder_detail
+
+// Collects edges chunk by chunk and builds a CsrGraph in one counting
+// sort. Text is "from to" lines, anything after the second id ignored
+// (weights), '#' or '%' lines skipped. A text chunk may end mid-line, the
+// rest waits for the next chunk. Chunks are parsed in parallel, one
+// newline-aligned slice per thread; edges keep input order.
+class GraphBuilder {
+ public:
+  explicit GraphBuilder(BuildOptions options = {})
+      : m_options(options),
+        m_local(std::max(options.threads, 1u)),
+        m_largest(m_local.size(), -1) {
+    m_options.threads = static_cast<unsigned>(m_local.size());
+  }
+
+  void AddText(std::string_view chunk) {
+    if (!m_pending.empty()) {
+      auto const eol = chunk.find('\n');
+      m_pending.append(chunk.substr(0, eol));
+      if (eol == std::string_view::npos) {
+        return;
+      }
+      m_pending.push_back('\n');
+      chunk.remove_prefix(eol + 1);
+      auto const line = std::exchange(m_pending, {});
+      ParseLines(line);
+    }
+    auto const last = chunk.rfind('\n');
+    if (last == std::string_view::npos) {
+      m_pending.assign(chunk);
+      return;
+    }
+    ParseLines(chunk.substr(0, last + 1));
+    m_pending.assign(chunk.substr(last + 1));
+  }
+
+  void AddEdges(std::span<Edge const> edges) {
+    for (auto const& edge : edges) {
+      if (edge.from < 0 || edge.to < 0) {
+        throw std::out_of_range("GraphBuilder: negative vertex id");
+      }
+      Keep(edge, m_edges, m_largest[0]);
+    }
+  }
+
+  // reads text until the stream ends, chunkBytes at a time
+  void AddTextStream(std::istream& in, std::size_t chunkBytes = std::size_t{1} << 24) {
+    std::string buffer(chunkBytes, '\0');
+    while (in) {
+      in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      AddText({buffer.data(), static_cast<std::size_t>(in.gcount())});
+    }
+  }
+
+  // raw native int32 from, to pairs
+  void AddBinaryStream(std::istream& in, std::size_t chunkEdges = std::size_t{1} << 20) {
+    std::vector<Edge> buffer(chunkEdges);
+    while (in) {
+      in.read(reinterpret_cast<char*>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size() * sizeof(Edge)));
+      auto const read = static_cast<std::size_t>(in.gcount());
+      if (read % sizeof(Edge) != 0) {
+        throw std::invalid_argument("GraphBuilder: binary stream ends mid-edge");
+      }
+      AddEdges(std::span{buffer}.first(read / sizeof(Edge)));
+    }
+  }
+
+  [[nodiscard]] std::size_t EdgeCount() const noexcept {
+    return m_edges.size();
+  }
+
+  // consumes the edges; a last line without newline counts too
+  [[nodiscard]] CsrGraph Build() {
+    if (!m_pending.empty()) {
+      m_pending.push_back('\n');
+      auto const line = std::exchange(m_pending, {});
+      ParseLines(line);
+    }
+    auto const largest = *std::ranges::max_element(m_largest);
+    auto const vertices = m_options.vertexCount != 0 ? m_options.vertexCount : largest + 1;
+    auto g = CsrGraph::FromEdges(m_edges, vertices, m_options.threads);
+    m_edges = {};
+    std::ranges::fill(m_largest, -1);
+    if (m_options.deduplicate) {
+      return Deduplicate(g);
+    }
+    return g;
+  }
+
+ private:
+  void Keep(Edge const& edge, std::vector<Edge>& out, int& largest) const {
+    if (m_options.dropSelfLoops && edge.from == edge.to) {
+      return;
+    }
+    out.push_back(edge);
+    largest = std::max({largest, edge.from, edge.to});
+  }
+
+  // whole lines only, the last one ends with '\n'
+  void ParseLines(std::string_view text) {
+    using namespace graph_builder_detail;
+    // small chunks aren't worth the threads
+    constexpr std::size_t kBytesPerThread = 1 << 16;
+    auto const workers = static_cast<unsigned>(
+        std::clamp<std::size_t>(text.size() / kBytesPerThread, 1, m_options.threads));
+    std::atomic<bool> invalid{false};
+    ParallelFor(workers, workers, [&](std::size_t slice, std::size_t, unsigned worker) {
+      // slice boundaries moved forward to the next line start
+      auto const boundary = [&](std::size_t i) -> std::size_t {
+        if (i == 0 || i >= workers) {
+          return i == 0 ? 0 : text.size();
+        }
+        auto const eol = text.find('\n', i * text.size() / workers - 1);
+        return eol == std::string_view::npos ? text.size() : eol + 1;
+      };
+      auto p = text.data() + boundary(slice);
+      auto const end = text.data() + boundary(slice + 1);
+      auto& out = m_local[worker];
+      while (p != end) {
+        SkipBlanks(p, end);
+        if (p == end || *p == '\n' || *p == '#' || *p == '%') {
+          SkipLine(p, end);
+          continue;
+        }
+        Edge edge;
+        auto ok = ParseVertex(p, end, edge.from);
+        SkipBlanks(p, end);
+        ok = ok && ParseVertex(p, end, edge.to);
+        if (!ok || (p != end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')) {
+          invalid.store(true, std::memory_order_relaxed);
+          return;
+        }
+        Keep(edge, out, m_largest[worker]);
+        SkipLine(p, end);
+      }
+    });
+    if (invalid.load(std::memory_order_relaxed)) {
+      for (auto& local : m_local) {
+        local.clear();
+      }
+      throw std::invalid_argument("GraphBuilder: expected two vertex ids per line");
+    }
+    // slices in order keep the input order
+    for (auto& local : m_local) {
+      m_edges.insert(m_edges.end(), local.begin(), local.end());
+      local.clear();
+    }
+  }
+
+  // Drops repeated targets per vertex with a stamp per target and thread,
+  // then packs the rest with a second prefix sum.
+  [[nodiscard]] CsrGraph Deduplicate(CsrGraph const& g) const {
+    auto const n = static_cast<std::size_t>(g.VertexCount());
+    auto const threads = static_cast<unsigned>(std::min<std::size_t>(m_options.threads, n));
+    std::vector<std::size_t> kept(n + 1, 0);
+    // unique targets first in each vertex's old range
+    std::vector<int> unique(g.EdgeCount());
+    ParallelFor(n, threads, [&](std::size_t begin, std::size_t end, unsigned) {
+      std::vector<int> stamp(n, -1);
+      for (auto v = begin; v < end; ++v) {
+        auto const self = static_cast<int>(v);
+        auto out = g.Offsets()[v];
+        for (int w : g.Neighbors(self)) {
+          if (std::exchange(stamp[static_cast<std::size_t>(w)], self) != self) {
+            unique[out++] = w;
+          }
+        }
+        kept[v + 1] = out - g.Offsets()[v];
+      }
+    });
+    for (std::size_t v = 0; v < n; ++v) {
+      kept[v + 1] += kept[v];
+    }
+    std::vector<int> targets(kept.back());
+    ParallelFor(n, threads, [&](std::size_t begin, std::size_t end, unsigned) {
+      for (auto v = begin; v < end; ++v) {
+        std::copy_n(unique.begin() + static_cast<std::ptrdiff_t>(g.Offsets()[v]),
+                    kept[v + 1] - kept[v], targets.begin() + static_cast<std::ptrdiff_t>(kept[v]));
+      }
+    });
+    return CsrGraph{std::move(kept), std::move(targets)};
+  }
+
+ private:
+  BuildOptions m_options;
+  std::vector<Edge> m_edges;
+  std::vector<std::vector<Edge>> m_local;
+  // largest id per thread slice
+  std::vector<int> m_largest;
+  std::string m_pending;
+};
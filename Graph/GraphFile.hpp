@@ -0,0 +1,456 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "CsrGraph.hpp"
+
+// clang-format off
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// clang-format on
+
+// Binary CSR file, native little-endian, every section 64-byte aligned:
+//   GraphFileHeader           64 bytes
+//   offsets  uint64_t[vertexCount + 1]
+//   targets  int32_t[edgeCount]
+//   weights  float[edgeCount]            only with kGraphFileWeights
+// The checksum covers the sections, padding included. Opening maps the
+// file and points spans at it: nothing is parsed or copied.
+
+inline constexpr char kGraphFileMagic[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+inline constexpr std::uint32_t kGraphFileVersion = 1;
+inline constexpr std::uint32_t kGraphFileWeights = 1;
+inline constexpr std::size_t kGraphFileAlignment = 64;
+
+struct GraphFileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t flags;
+  std::uint64_t vertexCount;
+  std::uint64_t edgeCount;
+  // byte positions in the file, weightsAt is 0 without weights
+  std::uint64_t offsetsAt;
+  std::uint64_t targetsAt;
+  std::uint64_t weightsAt;
+  std::uint64_t checksum;
+};
+
+static_assert(sizeof(GraphFileHeader) == 64);
+static_assert(std::endian::native == std::endian::little, "GraphFile is little-endian only");
+
+// Multiply-rotate over 64-bit words in four independent lanes, the tail
+// zero-padded; seed chains sections. Catches corruption, not tampering.
+[[nodiscard]] inline std::uint64_t GraphChecksum(std::span<std::byte const> bytes,
+                                                 std::uint64_t seed = 0) noexcept {
+  constexpr std::uint64_t kPrime = 0x9E3779B97F4A7C15ull;
+  std::uint64_t lanes[4] = {seed, seed + 1, seed + 2, seed + 3};
+  auto const words = bytes.size() / 8;
+  std::size_t i = 0;
+  for (; i + 4 <= words; i += 4) {
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+      std::uint64_t word;
+      std::memcpy(&word, bytes.data() + (i + lane) * 8, 8);
+      lanes[lane] = std::rotl((lanes[lane] ^ word) * kPrime, 29);
+    }
+  }
+  for (; i < words; ++i) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes.data() + i * 8, 8);
+    lanes[0] = std::rotl((lanes[0] ^ word) * kPrime, 29);
+  }
+  std::uint64_t tail = 0;
+  std::memcpy(&tail, bytes.data() + words * 8, bytes.size() % 8);
+  auto hash = (lanes[0] ^ tail) * kPrime;
+  for (std::size_t lane = 1; lane < 4; ++lane) {
+    hash = std::rotl(hash ^ lanes[lane], 31) * kPrime;
+  }
+  return hash ^ bytes.size();
+}
+
+// CSR arrays owned elsewhere, e.g. a mapped file
+struct CsrView {
+  std::span<std::uint64_t const> offsets{};
+  std::span<int const> targets{};
+  // empty or one per target
+  std::span<float const> weights{};
+
+  [[nodiscard]] int VertexCount() const noexcept {
+    return offsets.empty() ? 0 : static_cast<int>(offsets.size() - 1);
+  }
+
+  [[nodiscard]] std::size_t EdgeCount() const noexcept {
+    return targets.size();
+  }
+
+  [[nodiscard]] std::span<int const> Neighbors(int v) const noexcept {
+    auto const begin = offsets[static_cast<std::size_t>(v)];
+    return targets.subspan(begin, offsets[static_cast<std::size_t>(v) + 1] - begin);
+  }
+
+  [[nodiscard]] std::span<float const> Weights(int v) const noexcept {
+    auto const begin = offsets[static_cast<std::size_t>(v)];
+    return weights.subspan(begin, offsets[static_cast<std::size_t>(v) + 1] - begin);
+  }
+
+  [[nodiscard]] std::size_t Degree(int v) const noexcept {
+    return offsets[static_cast<std::size_t>(v) + 1] - offsets[static_cast<std::size_t>(v)];
+  }
+};
+
+inline int VertexCount(CsrView const& g) noexcept {
+  return g.VertexCount();
+}
+
+inline std::span<int const> Neighbors(CsrView const& g, int v) noexcept {
+  return g.Neighbors(v);
+}
+
+namespace graph_file_detail {
+inline std::uint64_t AlignUp(std::uint64_t position) noexcept {
+  return (position + kGraphFileAlignment - 1) / kGraphFileAlignment * kGraphFileAlignment;
+}
+
+// offsets, targets and weights with their padding, as laid out on disk
+inline std::uint64_t Checksum(std::span<std::byte const> file, GraphFileHeader const& header) {
+  auto const end = header.weightsAt != 0 ? header.weightsAt + header.edgeCount * sizeof(float)
+                                         : header.targetsAt + header.edgeCount * sizeof(int);
+  return GraphChecksum(file.subspan(header.offsetsAt, end - header.offsetsAt));
+}
+
+[[noreturn]] inline void Fail(std::filesystem::path const& path, char const* what) {
+  throw std::runtime_error("GraphFile " + path.string() + ": " + what);
+}
+}  // namespace graph_file_detail
+
+// Writes g (and one weight per edge, in CSR order, if given) to path.
+inline void WriteGraphFile(std::filesystem::path const& path, CsrGraph const& g,
+                           std::span<float const> weights = {}) {
+  using namespace graph_file_detail;
+  if (!weights.empty() && weights.size() != g.EdgeCount()) {
+    throw std::invalid_argument("WriteGraphFile: one weight per edge");
+  }
+  static_assert(sizeof(std::size_t) == sizeof(std::uint64_t));
+  GraphFileHeader header{};
+  std::memcpy(header.magic, kGraphFileMagic, sizeof(header.magic));
+  header.version = kGraphFileVersion;
+  header.flags = weights.empty() ? 0 : kGraphFileWeights;
+  header.vertexCount = static_cast<std::uint64_t>(g.VertexCount());
+  header.edgeCount = g.EdgeCount();
+  header.offsetsAt = AlignUp(sizeof(GraphFileHeader));
+  header.targetsAt = AlignUp(header.offsetsAt + g.Offsets().size_bytes());
+  header.weightsAt = weights.empty() ? 0 : AlignUp(header.targetsAt + g.Targets().size_bytes());
+
+  // the file image after the header, padding zeroed
+  auto const end = weights.empty() ? header.targetsAt + g.Targets().size_bytes()
+                                   : header.weightsAt + weights.size_bytes();
+  std::vector<std::byte> body(end - header.offsetsAt);
+  auto const place = [&](std::uint64_t at, std::span<std::byte const> bytes) {
+    std::memcpy(body.data() + (at - header.offsetsAt), bytes.data(), bytes.size());
+  };
+  place(header.offsetsAt, std::as_bytes(g.Offsets()));
+  place(header.targetsAt, std::as_bytes(g.Targets()));
+  if (!weights.empty()) {
+    place(header.weightsAt, std::as_bytes(weights));
+  }
+  header.checksum = GraphChecksum(body);
+
+  // the header fills the first aligned block, offsetsAt is right after it
+  static_assert(sizeof(GraphFileHeader) % kGraphFileAlignment == 0);
+  std::ofstream out{path, std::ios::binary | std::ios::trunc};
+  out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  out.write(reinterpret_cast<char const*>(body.data()), static_cast<std::streamsize>(body.size()));
+  if (!out) {
+    Fail(path, "write failed");
+  }
+}
+
+// A graph file mapped read-only. Opening checks the header and the section
+// bounds in O(1); Check::full also verifies the checksum, that offsets
+// never decrease and every target is a vertex, which reads the whole file.
+class MappedGraph {
+ public:
+  enum class Check { header, full };
+
+  explicit MappedGraph(std::filesystem::path const& path, Check check = Check::header) {
+    Map(path);
+    try {
+      Validate(path, check);
+    } catch (...) {
+      Unmap();
+      throw;
+    }
+  }
+
+  MappedGraph(MappedGraph&& other) noexcept
+      : m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_view(std::exchange(other.m_view, {})) {
+  }
+
+  MappedGraph& operator=(MappedGraph&& other) noexcept {
+    if (this != &other) {
+      Unmap();
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+      m_view = std::exchange(other.m_view, {});
+    }
+    return *this;
+  }
+
+  ~MappedGraph() {
+    Unmap();
+  }
+
+  [[nodiscard]] CsrView const& View() const noexcept {
+    return m_view;
+  }
+
+  [[nodiscard]] int VertexCount() const noexcept {
+    return m_view.VertexCount();
+  }
+
+  [[nodiscard]] std::size_t EdgeCount() const noexcept {
+    return m_view.EdgeCount();
+  }
+
+  [[nodiscard]] std::span<int const> Neighbors(int v) const noexcept {
+    return m_view.Neighbors(v);
+  }
+
+  [[nodiscard]] bool HasWeights() const noexcept {
+    return Header().weightsAt != 0;
+  }
+
+  [[nodiscard]] GraphFileHeader const& Header() const noexcept {
+    return *reinterpret_cast<GraphFileHeader const*>(m_data);
+  }
+
+  // an owning copy, for when the file has to go
+  [[nodiscard]] CsrGraph ToCsrGraph() const {
+    return CsrGraph{std::vector<std::size_t>(m_view.offsets.begin(), m_view.offsets.end()),
+                    std::vector<int>(m_view.targets.begin(), m_view.targets.end())};
+  }
+
+ private:
+  void Map(std::filesystem::path const& path) {
+    using graph_file_detail::Fail;
+#ifdef _WIN32
+    auto const file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      Fail(path, "can't open");
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size < sizeof(GraphFileHeader)) {
+      CloseHandle(file);
+      Fail(path, "too short for a header");
+    }
+    auto const mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping != nullptr) {
+      m_data = static_cast<std::byte const*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+      CloseHandle(mapping);
+    }
+#else
+    auto const fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      Fail(path, "can't open");
+    }
+    struct stat info {};
+    fstat(fd, &info);
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size < sizeof(GraphFileHeader)) {
+      close(fd);
+      Fail(path, "too short for a header");
+    }
+    auto const ptr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    m_data = ptr == MAP_FAILED ? nullptr : static_cast<std::byte const*>(ptr);
+    close(fd);
+#endif
+    if (m_data == nullptr) {
+      m_size = 0;
+      Fail(path, "can't map");
+    }
+  }
+
+  void Unmap() noexcept {
+    if (m_data != nullptr) {
+#ifdef _WIN32
+      UnmapViewOfFile(m_data);
+#else
+      munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+  }
+
+  void Validate(std::filesystem::path const& path, Check check) {
+    using namespace graph_file_detail;
+    auto const& header = Header();
+    if (std::memcmp(header.magic, kGraphFileMagic, sizeof(header.magic)) != 0) {
+      Fail(path, "not a graph file");
+    }
+    if (header.version != kGraphFileVersion) {
+      Fail(path, "unsupported version");
+    }
+    auto const n = header.vertexCount;
+    auto const m = header.edgeCount;
+    auto const fits = [&](std::uint64_t at, std::uint64_t count, std::size_t size) {
+      return at % kGraphFileAlignment == 0 && at >= sizeof(GraphFileHeader) && at <= m_size &&
+             count <= (m_size - at) / size;
+    };
+    bool const weighted = (header.flags & kGraphFileWeights) != 0;
+    if (n >= static_cast<std::uint64_t>(std::numeric_limits<int>::max()) ||
+        !fits(header.offsetsAt, n + 1, sizeof(std::uint64_t)) ||
+        !fits(header.targetsAt, m, sizeof(int)) ||
+        weighted != (header.weightsAt != 0) ||
+        (weighted && !fits(header.weightsAt, m, sizeof(float)))) {
+      Fail(path, "sections out of bounds");
+    }
+
+    m_view.offsets = {reinterpret_cast<std::uint64_t const*>(m_data + header.offsetsAt), n + 1};
+    m_view.targets = {reinterpret_cast<int const*>(m_data + header.targetsAt), m};
+    if (weighted) {
+      m_view.weights = {reinterpret_cast<float const*>(m_data + header.weightsAt), m};
+    }
+    if (m_view.offsets.front() != 0 || m_view.offsets.back() != m) {
+      Fail(path, "offsets don't match targets");
+    }
+
+    if (check == Check::full) {
+      if (Checksum({m_data, m_size}, header) != header.checksum) {
+        Fail(path, "checksum mismatch");
+      }
+      for (std::size_t v = 0; v < n; ++v) {
+        if (m_view.offsets[v] > m_view.offsets[v + 1]) {
+          Fail(path, "offsets decrease");
+        }
+      }
+      for (int target : m_view.targets) {
+        if (target < 0 || static_cast<std::uint64_t>(target) >= n) {
+          Fail(path, "target out of range");
+        }
+      }
+    }
+  }
+
+ private:
+  std::byte const* m_data = nullptr;
+  std::size_t m_size = 0;
+  CsrView m_view;
+};
+
+inline int VertexCount(MappedGraph const& g) noexcept {
+  return g.VertexCount();
+}
+
+inline std::span<int const> Neighbors(MappedGraph const& g, int v) noexcept {
+  return g.Neighbors(v);
+}
+
+// "from to" or "from to weight" per line, '#' or '%' starts a comment line.
+// Weights are all or nothing. vertexCount is the largest id + 1.
+struct EdgeList {
+  std::vector<Edge> edges;
+  std::vector<float> weights;
+  int vertexCount = 0;
+};
+
+[[nodiscard]] inline EdgeList ParseEdgeList(std::string_view text) {
+  EdgeList list;
+  auto const fail = [&](char const* what, std::size_t line) {
+    throw std::invalid_argument("ParseEdgeList: line " + std::to_string(line) + ": " + what);
+  };
+  std::size_t lineNumber = 0;
+  while (!text.empty()) {
+    ++lineNumber;
+    auto const eol = text.find('\n');
+    auto line = text.substr(0, eol);
+    text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+
+    auto const skipBlanks = [&] {
+      auto const blanks = line.find_first_not_of(" \t\r");
+      line.remove_prefix(blanks == std::string_view::npos ? line.size() : blanks);
+    };
+    skipBlanks();
+    if (line.empty() || line.front() == '#' || line.front() == '%') {
+      continue;
+    }
+    int ends[2];
+    for (auto& end : ends) {
+      auto const [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), end);
+      if (ec != std::errc{} || end < 0) {
+        fail("expected a vertex id", lineNumber);
+      }
+      line.remove_prefix(static_cast<std::size_t>(ptr - line.data()));
+      skipBlanks();
+    }
+    list.edges.push_back({ends[0], ends[1]});
+    list.vertexCount = std::max({list.vertexCount, ends[0] + 1, ends[1] + 1});
+
+    bool const weighted = !line.empty();
+    if (list.edges.size() > 1 && weighted != !list.weights.empty()) {
+      fail("weights are all or nothing", lineNumber);
+    }
+    if (weighted) {
+      float weight;
+      auto const [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), weight);
+      line.remove_prefix(static_cast<std::size_t>(ptr - line.data()));
+      skipBlanks();
+      if (ec != std::errc{} || !line.empty()) {
+        fail("expected a weight", lineNumber);
+      }
+      list.weights.push_back(weight);
+    }
+  }
+  return list;
+}
+
+// Text edge list file -> binary graph file. Weights follow their edges
+// into CSR order (FromEdges is stable).
+inline void ConvertEdgeList(std::filesystem::path const& textPath,
+                            std::filesystem::path const& graphPath) {
+  std::ifstream in{textPath, std::ios::binary};
+  if (!in) {
+    graph_file_detail::Fail(textPath, "can't open");
+  }
+  std::string const text{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+  auto const list = ParseEdgeList(text);
+  auto const g = CsrGraph::FromEdges(list.edges, list.vertexCount);
+  std::vector<float> weights(list.weights.size());
+  if (!weights.empty()) {
+    std::vector<std::size_t> cursor(g.Offsets().begin(), g.Offsets().end() - 1);
+    for (std::size_t i = 0; i < list.edges.size(); ++i) {
+      weights[cursor[static_cast<std::size_t>(list.edges[i].from)]++] = list.weights[i];
+    }
+  }
+  WriteGraphFile(graphPath, g, weights);
+}
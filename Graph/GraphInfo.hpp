@@ -1,24 +1,68 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <vector>
-#include <string>
 
-struct GraphInfo {
-    std::vector<std::vector<int>> g;
+#include "CsrGraph.hpp"
+
+enum class Color : std::uint8_t { white, grey, black };
+
+// a vertex on the explicit Dfs stack and its next neighbour to look at
+struct DfsFrame {
+    int vertex;
+    std::size_t next;
+};
+
+template <typename Graph>
+struct BasicGraphInfo {
+    Graph g;
     std::vector<int> tIn, tOut;
     int timer = 0;
-    std::vector<std::string> color;
+    std::vector<Color> color;
     std::vector<int> parent;
+    // kept between calls, grows to the deepest path seen
+    std::vector<DfsFrame> stack;
 };
 
-inline void Dfs(GraphInfo & info, int v, int p = - 1) {
+using GraphInfo = BasicGraphInfo<std::vector<std::vector<int>>>;
+using CsrGraphInfo = BasicGraphInfo<CsrGraph>;
+
+// Same tIn/tOut/parent/color as the recursive definition, without recursion:
+// enter v (tIn, parent, grey), walk its white neighbours in order, leave v
+// (tOut, black). Depth is bounded by memory, not the call stack.
+template <typename Graph>
+inline void Dfs(BasicGraphInfo<Graph> & info, int v, int p = - 1) {
+    auto& stack = info.stack;
+    stack.clear();
+
     info.tIn[v] = info.timer++;
     info.parent[v] = p;
-    info.color[v] = "grey";
-    for (int to : info.g[v]) {
-        if (info.color[to] == "white") {
-            Dfs(info, to, v);
+    info.color[v] = Color::grey;
+    stack.push_back({v, 0});
+    while (!stack.empty()) {
+        auto& frame = stack.back();
+        auto const neighbors = Neighbors(info.g, frame.vertex);
+        while (frame.next < neighbors.size() && info.color[neighbors[frame.next]] != Color::white) {
+            ++frame.next;
+        }
+        if (frame.next == neighbors.size()) {
+            info.tOut[frame.vertex] = info.timer++;
+            info.color[frame.vertex] = Color::black;
+            stack.pop_back();
+            continue;
         }
+
+        int const to = neighbors[frame.next++];
+        info.tIn[to] = info.timer++;
+        info.parent[to] = frame.vertex;
+        info.color[to] = Color::grey;
+        // invalidates frame
+        stack.push_back({to, 0});
     }
-    info.tOut[v] = info.timer++;
-    info.color[v] = "black";
+}
+
+// u is v or one of its ancestors, both visited by one Dfs
+template <typename Graph>
+inline bool IsAncestor(BasicGraphInfo<Graph> const & info, int u, int v) {
+    return info.tIn[u] <= info.tIn[v] && info.tOut[v] <= info.tOut[u];
 }
@@ -0,0 +1,215 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "DfsWorkspace.hpp"
+
+// Static ancestor and LCA queries over a DFS forest, O(n) build and O(1)
+// queries.
+//
+// Vertices are laid out in preorder (the entry half of the Euler tour).
+// For u before v in preorder, lca(u, v) is the parent of the shallowest
+// vertex in preorder positions (pos(u), pos(v)]: that's a range minimum
+// over keys depth << 32 | parent. The RMQ is the block decomposition:
+// a sparse table over the minima of 32-key blocks, and per position a
+// mask of the in-block stack of smaller keys, so a query inside a block
+// is one count of trailing zeros.
+class LcaIndex {
+ public:
+  LcaIndex() = default;
+
+  // forest must cover every vertex, e.g. DfsWorkspace::VisitAll
+  explicit LcaIndex(DfsForest const& forest) {
+    auto const n = forest.parent.size();
+    if (forest.tIn.size() != n || forest.tOut.size() != n) {
+      throw std::invalid_argument("LcaIndex: forest arrays differ in size");
+    }
+    // preorder by tIn, which is unique and below 2n
+    std::vector<int> byTime(2 * n, -1);
+    for (std::size_t v = 0; v < n; ++v) {
+      byTime[static_cast<std::size_t>(forest.tIn[v])] = static_cast<int>(v);
+    }
+    std::vector<int> order;
+    order.reserve(n);
+    for (int v : byTime) {
+      if (v != -1) {
+        order.push_back(v);
+      }
+    }
+    if (order.size() != n) {
+      throw std::invalid_argument("LcaIndex: forest doesn't cover every vertex");
+    }
+
+    m_vertex.resize(n);
+    m_key.resize(n);
+    std::vector<std::uint32_t> depth(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      auto const v = static_cast<std::size_t>(order[i]);
+      auto const parent = forest.parent[v];
+      auto& entry = m_vertex[v];
+      entry.position = static_cast<int>(i);
+      if (parent == -1) {
+        depth[v] = 0;
+        entry.root = static_cast<int>(v);
+      } else {
+        depth[v] = depth[static_cast<std::size_t>(parent)] + 1;
+        entry.root = m_vertex[static_cast<std::size_t>(parent)].root;
+      }
+      m_key[i] = std::uint64_t{depth[v]} << 32 | static_cast<std::uint32_t>(parent);
+    }
+    // a subtree is a contiguous preorder range
+    for (std::size_t v = 0; v < n; ++v) {
+      m_vertex[v].end = m_vertex[v].position + (forest.tOut[v] - forest.tIn[v] + 1) / 2;
+    }
+    BuildRmq();
+  }
+
+  [[nodiscard]] int VertexCount() const noexcept {
+    return static_cast<int>(m_vertex.size());
+  }
+
+  // u is v or one of its ancestors
+  [[nodiscard]] bool IsAncestor(int u, int v) const noexcept {
+    auto const& a = m_vertex[static_cast<std::size_t>(u)];
+    auto const position = m_vertex[static_cast<std::size_t>(v)].position;
+    return a.position <= position && position < a.end;
+  }
+
+  // -1 if u and v are in different trees
+  [[nodiscard]] int Lca(int u, int v) const noexcept {
+    return Lca(m_vertex[static_cast<std::size_t>(u)], m_vertex[static_cast<std::size_t>(v)], u);
+  }
+
+  // out[i] = Lca(queries[i]). Queries go in chunks: first every vertex
+  // entry of the chunk is loaded, then the chunk is answered, so the
+  // cache misses of a chunk overlap instead of queueing behind each other.
+  void Lca(std::span<std::pair<int, int> const> queries, std::span<int> out) const {
+    if (out.size() < queries.size()) {
+      throw std::invalid_argument("LcaIndex: out is shorter than queries");
+    }
+    constexpr std::size_t kChunk = 64;
+    Vertex first[kChunk];
+    Vertex second[kChunk];
+    for (std::size_t begin = 0; begin < queries.size(); begin += kChunk) {
+      auto const size = std::min(kChunk, queries.size() - begin);
+      for (std::size_t i = 0; i < size; ++i) {
+        first[i] = m_vertex[static_cast<std::size_t>(queries[begin + i].first)];
+        second[i] = m_vertex[static_cast<std::size_t>(queries[begin + i].second)];
+      }
+      for (std::size_t i = 0; i < size; ++i) {
+        out[begin + i] = Lca(first[i], second[i], queries[begin + i].first);
+      }
+    }
+  }
+
+  [[nodiscard]] int Depth(int v) const noexcept {
+    return static_cast<int>(m_key[static_cast<std::size_t>(Position(v))] >> 32);
+  }
+
+  // preorder position, subtrees are [Position(v), Position(v) + SubtreeSize(v))
+  [[nodiscard]] int Position(int v) const noexcept {
+    return m_vertex[static_cast<std::size_t>(v)].position;
+  }
+
+  [[nodiscard]] int SubtreeSize(int v) const noexcept {
+    auto const& entry = m_vertex[static_cast<std::size_t>(v)];
+    return entry.end - entry.position;
+  }
+
+ private:
+  static constexpr std::size_t kBlock = 32;
+
+  // what a query needs of a vertex, in one place
+  struct Vertex {
+    int position;
+    int end;
+    int root;
+  };
+
+  [[nodiscard]] int Lca(Vertex const& a, Vertex const& b, int u) const noexcept {
+    if (a.root != b.root) {
+      return -1;
+    }
+    if (a.position == b.position) {
+      return u;
+    }
+    auto const [low, high] = std::minmax(a.position, b.position);
+    auto const key = Min(static_cast<std::size_t>(low) + 1, static_cast<std::size_t>(high));
+    return static_cast<int>(static_cast<std::uint32_t>(key));
+  }
+
+  void BuildRmq() {
+    auto const n = m_key.size();
+    m_mask.resize(n);
+    auto const blocks = (n + kBlock - 1) / kBlock;
+    std::vector<std::uint64_t> blockMin(blocks);
+    for (std::size_t block = 0; block < blocks; ++block) {
+      auto const begin = block * kBlock;
+      auto const end = std::min(n, begin + kBlock);
+      // in-block offsets whose keys are below everything after them so far
+      std::uint32_t stack = 0;
+      for (auto i = begin; i < end; ++i) {
+        while (stack != 0) {
+          auto const top = 31 - std::countl_zero(stack);
+          if (m_key[begin + static_cast<std::size_t>(top)] < m_key[i]) {
+            break;
+          }
+          stack &= ~(std::uint32_t{1} << top);
+        }
+        stack |= std::uint32_t{1} << (i - begin);
+        m_mask[i] = stack;
+      }
+      blockMin[block] = *std::min_element(m_key.begin() + static_cast<std::ptrdiff_t>(begin),
+                                          m_key.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+
+    m_table.assign(1, std::move(blockMin));
+    for (std::size_t width = 1; 2 * width <= blocks; width *= 2) {
+      auto const& previous = m_table.back();
+      std::vector<std::uint64_t> level(blocks - 2 * width + 1);
+      for (std::size_t i = 0; i < level.size(); ++i) {
+        level[i] = std::min(previous[i], previous[i + width]);
+      }
+      m_table.push_back(std::move(level));
+    }
+  }
+
+  // smallest key in positions [first, last] of one block
+  [[nodiscard]] std::uint64_t InBlock(std::size_t first, std::size_t last) const noexcept {
+    auto const begin = first / kBlock * kBlock;
+    auto const mask = m_mask[last] & (~std::uint32_t{0} << (first - begin));
+    return m_key[begin + static_cast<std::size_t>(std::countr_zero(mask))];
+  }
+
+  // smallest key in positions [first, last]
+  [[nodiscard]] std::uint64_t Min(std::size_t first, std::size_t last) const noexcept {
+    auto const firstBlock = first / kBlock;
+    auto const lastBlock = last / kBlock;
+    if (firstBlock == lastBlock) {
+      return InBlock(first, last);
+    }
+    auto result = std::min(InBlock(first, firstBlock * kBlock + kBlock - 1),
+                           InBlock(lastBlock * kBlock, last));
+    if (firstBlock + 1 < lastBlock) {
+      auto const count = lastBlock - firstBlock - 1;
+      auto const level = static_cast<std::size_t>(std::bit_width(count) - 1);
+      auto const& row = m_table[level];
+      result = std::min({result, row[firstBlock + 1], row[lastBlock - (std::size_t{1} << level)]});
+    }
+    return result;
+  }
+
+ private:
+  std::vector<Vertex> m_vertex;
+  // by preorder position
+  std::vector<std::uint64_t> m_key;
+  std::vector<std::uint32_t> m_mask;
+  // m_table[k][b]: smallest key of blocks [b, b + 2^k)
+  std::vector<std::vector<std::uint64_t>> m_table;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// hardware threads, at least one
+inline unsigned DefaultThreads() noexcept {
+  auto const threads = std::thread::hardware_concurrency();
+  return threads == 0 ? 1 : threads;
+}
+
+// Splits [0, count) into at most `threads` contiguous chunks and runs
+// fn(begin, end, worker) on each, chunk 0 on the calling thread.
+// Returns when every chunk is done. fn must not throw.
+template <typename Fn>
+void ParallelFor(std::size_t count, unsigned threads, Fn&& fn) {
+  auto const workers = static_cast<std::size_t>(
+      std::max<std::size_t>(1, std::min<std::size_t>(threads, count)));
+  auto const chunk = (count + workers - 1) / std::max<std::size_t>(workers, 1);
+  std::vector<std::jthread> pool;
+  pool.reserve(workers - 1);
+  for (std::size_t worker = 1; worker < workers; ++worker) {
+    auto const begin = std::min(count, worker * chunk);
+    auto const end = std::min(count, begin + chunk);
+    pool.emplace_back([&fn, begin, end, worker] {
+      fn(begin, end, static_cast<unsigned>(worker));
+    });
+  }
+  fn(std::size_t{0}, std::min(count, chunk), 0u);
+}
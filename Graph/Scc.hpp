@@ -0,0 +1,313 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "Bfs.hpp"
+#include "GraphInfo.hpp"
+
+// Strongly connected components as one id per vertex, ids 0 .. count - 1.
+struct SccInfo {
+  std::vector<int> component;
+  int count = 0;
+};
+
+// Iterative Tarjan. Ids follow a topological order of the condensation:
+// component[u] <= component[v] for every edge u -> v.
+template <AdjacencyGraph Graph>
+[[nodiscard]] SccInfo TarjanScc(Graph const& g) {
+  auto const n = static_cast<std::size_t>(VertexCount(g));
+  SccInfo info{std::vector<int>(n, -1), 0};
+  std::vector<int> index(n, -1);
+  std::vector<int> low(n);
+  // visited vertices without a component yet
+  std::vector<int> open;
+  std::vector<DfsFrame> frames;
+  int timer = 0;
+
+  auto const enter = [&](int v) {
+    index[v] = low[v] = timer++;
+    open.push_back(v);
+    frames.push_back({v, 0});
+  };
+
+  for (int root = 0; root < static_cast<int>(n); ++root) {
+    if (index[root] != -1) {
+      continue;
+    }
+    enter(root);
+    while (!frames.empty()) {
+      auto& frame = frames.back();
+      int const v = frame.vertex;
+      auto const neighbors = Neighbors(g, v);
+      if (frame.next < neighbors.size()) {
+        int const w = neighbors[frame.next++];
+        if (index[w] == -1) {
+          // invalidates frame
+          enter(w);
+        } else if (info.component[w] == -1) {
+          low[v] = std::min(low[v], index[w]);
+        }
+        continue;
+      }
+      frames.pop_back();
+      if (!frames.empty()) {
+        auto const parent = frames.back().vertex;
+        low[parent] = std::min(low[parent], low[v]);
+      }
+      if (low[v] == index[v]) {
+        int w;
+        do {
+          w = open.back();
+          open.pop_back();
+          info.component[w] = info.count;
+        } while (w != v);
+        ++info.count;
+      }
+    }
+  }
+  // Tarjan finishes sink components first
+  for (auto& id : info.component) {
+    id = info.count - 1 - id;
+  }
+  return info;
+}
+
+namespace scc_detail {
+using bfs_detail::Gather;
+using bfs_detail::Workers;
+
+// Level-synchronous: step(u, out) appends what u reaches to out, the next
+// frontier, until a frontier comes back empty.
+template <typename Step>
+void Expand(std::vector<int> frontier, unsigned threads, std::vector<std::vector<int>>& local,
+            Step&& step) {
+  while (!frontier.empty()) {
+    ParallelFor(frontier.size(), Workers(frontier.size(), threads),
+                [&](std::size_t first, std::size_t last, unsigned worker) {
+                  for (auto i = first; i < last; ++i) {
+                    step(frontier[i], local[worker]);
+                  }
+                });
+    Gather(local, frontier, threads);
+  }
+}
+
+// the vertices of [0, n) that pass keep(v), in increasing order
+template <typename Keep>
+std::vector<int> Collect(std::size_t n, unsigned threads, std::vector<std::vector<int>>& local,
+                         Keep&& keep) {
+  ParallelFor(n, Workers(n, threads), [&](std::size_t first, std::size_t last, unsigned worker) {
+    for (auto v = first; v < last; ++v) {
+      if (keep(static_cast<int>(v))) {
+        local[worker].push_back(static_cast<int>(v));
+      }
+    }
+  });
+  std::vector<int> out;
+  Gather(local, out, threads);
+  return out;
+}
+
+class ParallelSccState {
+ public:
+  ParallelSccState(CsrGraph const& g, CsrGraph const& reverse, unsigned threads)
+      : m_g(g),
+        m_reverse(reverse),
+        m_n(static_cast<std::size_t>(g.VertexCount())),
+        m_threads(threads),
+        m_done(m_n),
+        m_component(m_n, -1),
+        m_local(threads) {
+  }
+
+  // Peels vertices without remaining in- or out-edges, and whatever that
+  // leaves without them, as one-vertex components. Takes out the acyclic
+  // parts of dependency graphs in O(n + m).
+  void Trim() {
+    std::vector<std::atomic<int>> in(m_n);
+    std::vector<std::atomic<int>> out(m_n);
+    auto const remaining = [&](std::span<int const> neighbors, int v) {
+      return static_cast<int>(std::ranges::count_if(
+          neighbors, [&](int w) { return w != v && !m_done.Test(static_cast<std::size_t>(w)); }));
+    };
+    auto peeled = Collect(m_n, m_threads, m_local, [&](int v) {
+      if (m_done.Test(static_cast<std::size_t>(v))) {
+        return false;
+      }
+      in[v].store(remaining(m_reverse.Neighbors(v), v), std::memory_order_relaxed);
+      out[v].store(remaining(m_g.Neighbors(v), v), std::memory_order_relaxed);
+      return in[v].load(std::memory_order_relaxed) == 0 ||
+             out[v].load(std::memory_order_relaxed) == 0;
+    });
+    for (int v : peeled) {
+      Claim(v, NewId());
+    }
+
+    auto const release = [&](int u, std::vector<int>& next, CsrGraph const& graph,
+                             std::vector<std::atomic<int>>& degree) {
+      for (int w : graph.Neighbors(u)) {
+        if (w != u && degree[w].fetch_sub(1, std::memory_order_relaxed) == 1 && Claim(w)) {
+          m_component[w] = NewId();
+          next.push_back(w);
+        }
+      }
+    };
+    Expand(std::move(peeled), m_threads, m_local, [&](int u, std::vector<int>& next) {
+      release(u, next, m_g, in);
+      release(u, next, m_reverse, out);
+    });
+  }
+
+  // Forward-backward from the vertex with the largest in * out degree:
+  // what it reaches and what reaches it back is its component, usually
+  // the giant one.
+  void ForwardBackward() {
+    auto const candidates = Remaining();
+    if (candidates.empty()) {
+      return;
+    }
+    auto const weight = [&](int v) {
+      return (m_g.Degree(v) + 1) * (m_reverse.Degree(v) + 1);
+    };
+    int const pivot = *std::ranges::max_element(candidates, {}, weight);
+
+    AtomicBitmap forward{m_n};
+    forward.TrySet(static_cast<std::size_t>(pivot));
+    Expand({pivot}, m_threads, m_local, [&](int u, std::vector<int>& next) {
+      for (int w : m_g.Neighbors(u)) {
+        auto const slot = static_cast<std::size_t>(w);
+        if (!m_done.Test(slot) && !forward.Test(slot) && forward.TrySet(slot)) {
+          next.push_back(w);
+        }
+      }
+    });
+
+    int const id = NewId();
+    Claim(pivot, id);
+    Expand({pivot}, m_threads, m_local, [&](int u, std::vector<int>& next) {
+      for (int w : m_reverse.Neighbors(u)) {
+        if (forward.Test(static_cast<std::size_t>(w)) && Claim(w, id)) {
+          next.push_back(w);
+        }
+      }
+    });
+  }
+
+  // Rounds of coloring: every vertex takes the largest id that reaches it,
+  // then each vertex still holding its own id collects, backwards over its
+  // color, one component. Every round finishes at least one component.
+  void Coloring() {
+    std::vector<std::atomic<int>> color(m_n);
+    for (auto vertices = Remaining(); !vertices.empty(); vertices = Remaining()) {
+      for (int v : vertices) {
+        color[v].store(v, std::memory_order_relaxed);
+      }
+      Expand(vertices, m_threads, m_local, [&](int u, std::vector<int>& next) {
+        auto const c = color[u].load(std::memory_order_relaxed);
+        for (int w : m_g.Neighbors(u)) {
+          if (m_done.Test(static_cast<std::size_t>(w))) {
+            continue;
+          }
+          auto current = color[w].load(std::memory_order_relaxed);
+          while (current < c &&
+                 !color[w].compare_exchange_weak(current, c, std::memory_order_relaxed)) {
+          }
+          if (current < c) {
+            next.push_back(w);
+          }
+        }
+      });
+
+      auto roots = Collect(vertices.size(), m_threads, m_local, [&](int i) {
+        return color[vertices[i]].load(std::memory_order_relaxed) == vertices[i];
+      });
+      for (auto& root : roots) {
+        root = vertices[root];
+        Claim(root, NewId());
+      }
+      Expand(std::move(roots), m_threads, m_local, [&](int u, std::vector<int>& next) {
+        auto const c = color[u].load(std::memory_order_relaxed);
+        for (int w : m_reverse.Neighbors(u)) {
+          if (color[w].load(std::memory_order_relaxed) == c && Claim(w, m_component[c])) {
+            next.push_back(w);
+          }
+        }
+      });
+    }
+  }
+
+  SccInfo Result() && {
+    return {std::move(m_component), m_nextId.load()};
+  }
+
+ private:
+  int NewId() noexcept {
+    return m_nextId.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // false if v already had a component
+  bool Claim(int v) noexcept {
+    auto const slot = static_cast<std::size_t>(v);
+    return !m_done.Test(slot) && m_done.TrySet(slot);
+  }
+
+  bool Claim(int v, int id) noexcept {
+    if (!Claim(v)) {
+      return false;
+    }
+    m_component[static_cast<std::size_t>(v)] = id;
+    return true;
+  }
+
+  std::vector<int> Remaining() {
+    return Collect(m_n, m_threads, m_local,
+                   [&](int v) { return !m_done.Test(static_cast<std::size_t>(v)); });
+  }
+
+ private:
+  CsrGraph const& m_g;
+  CsrGraph const& m_reverse;
+  std::size_t m_n;
+  unsigned m_threads;
+  AtomicBitmap m_done;
+  std::vector<int> m_component;
+  std::atomic<int> m_nextId{0};
+  std::vector<std::vector<int>> m_local;
+};
+}  // namespace scc_detail
+
+// Parallel SCC for big graphs, reverse must be g.Transposed(): trim,
+// forward-backward for the giant component, trim again, then coloring
+// rounds for the rest. Same partition as TarjanScc, ids in no particular
+// order.
+[[nodiscard]] inline SccInfo ParallelScc(CsrGraph const& g, CsrGraph const& reverse,
+                                         unsigned threads = DefaultThreads()) {
+  if (reverse.VertexCount() != g.VertexCount() || reverse.EdgeCount() != g.EdgeCount()) {
+    throw std::invalid_argument("ParallelScc: reverse is not the transpose of g");
+  }
+  scc_detail::ParallelSccState state{g, reverse, std::max(threads, 1u)};
+  state.Trim();
+  state.ForwardBackward();
+  state.Trim();
+  state.Coloring();
+  return std::move(state).Result();
+}
+
+// true if g has a directed cycle, self-loops included, given its components
+template <AdjacencyGraph Graph>
+[[nodiscard]] bool HasCycle(Graph const& g, SccInfo const& scc) {
+  if (scc.count != VertexCount(g)) {
+    return true;
+  }
+  for (int v = 0; v < VertexCount(g); ++v) {
+    auto const neighbors = Neighbors(g, v);
+    if (std::ranges::find(neighbors, v) != neighbors.end()) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,86 @@
+#include <climits>
+#include <random>
+#include <vector>
+
+#include "../Bfs.hpp"
+#include <benchmark/benchmark.h>
+
+// Sequential queue BFS against the parallel one, top-down only and
+// direction-optimizing, on a random graph with average out-degree 16.
+// The thread count is the second argument.
+
+namespace {
+constexpr int kDegree = 16;
+
+CsrGraph const& Graph(int vertices) {
+  static int cached = -1;
+  static CsrGraph g;
+  if (cached != vertices) {
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> vertex{0, vertices - 1};
+    std::vector<Edge> edges(static_cast<std::size_t>(vertices) * kDegree);
+    for (auto& edge : edges) {
+      edge = {vertex(gen), vertex(gen)};
+    }
+    g = CsrGraph::FromEdges(edges, vertices);
+    cached = vertices;
+  }
+  return g;
+}
+
+void BM_SequentialBfs(benchmark::State& state) {
+  auto const& g = Graph(static_cast<int>(state.range(0)));
+  auto const n = static_cast<std::size_t>(g.VertexCount());
+  std::vector<int> queue(n);
+  for (auto _ : state) {
+    BfsInfo info{std::vector<int>(n, -1), std::vector<int>(n, -1)};
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    info.distance[0] = 0;
+    queue[tail++] = 0;
+    while (head != tail) {
+      auto const v = queue[head++];
+      for (int to : g.Neighbors(v)) {
+        if (info.distance[to] == -1) {
+          info.distance[to] = info.distance[v] + 1;
+          info.parent[to] = v;
+          queue[tail++] = to;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(info.distance.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.EdgeCount()));
+}
+
+void RunBfs(benchmark::State& state, BfsOptions options) {
+  auto const& g = Graph(static_cast<int>(state.range(0)));
+  auto const reverse = g.Transposed();
+  options.threads = static_cast<unsigned>(state.range(1));
+  for (auto _ : state) {
+    auto info = Bfs(g, reverse, 0, options);
+    benchmark::DoNotOptimize(info.distance.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.EdgeCount()));
+}
+
+void BM_TopDownBfs(benchmark::State& state) {
+  RunBfs(state, {.alpha = 1});
+}
+
+void BM_DirectionOptimizingBfs(benchmark::State& state) {
+  RunBfs(state, {});
+}
+
+void Threads(benchmark::internal::Benchmark* bench) {
+  for (int vertices : {1 << 16, 1 << 20}) {
+    for (int threads = 1; threads <= static_cast<int>(DefaultThreads()); threads *= 2) {
+      bench->Args({vertices, threads});
+    }
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_SequentialBfs)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_TopDownBfs)->Apply(Threads)->UseRealTime();
+BENCHMARK(BM_DirectionOptimizingBfs)->Apply(Threads)->UseRealTime();
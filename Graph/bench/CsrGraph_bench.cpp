@@ -0,0 +1,111 @@
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "../CsrGraph.hpp"
+#include "../GraphInfo.hpp"
+#include <benchmark/benchmark.h>
+
+// vector<vector<int>> against CsrGraph on the same random graph, average
+// out-degree 8, plus the cost of building the CSR arrays.
+
+namespace {
+constexpr int kDegree = 8;
+
+std::vector<Edge> RandomEdges(int vertices) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<Edge> edges(static_cast<std::size_t>(vertices) * kDegree);
+  for (auto& edge : edges) {
+    edge = {vertex(gen), vertex(gen)};
+  }
+  return edges;
+}
+
+std::vector<std::vector<int>> Lists(std::vector<Edge> const& edges, int vertices) {
+  std::vector<std::vector<int>> g(vertices);
+  for (auto [from, to] : edges) {
+    g[from].push_back(to);
+  }
+  return g;
+}
+
+template <typename Graph>
+Graph Make(std::vector<Edge> const& edges, int vertices) {
+  if constexpr (std::is_same_v<Graph, CsrGraph>) {
+    return CsrGraph::FromEdges(edges, vertices);
+  } else {
+    return Lists(edges, vertices);
+  }
+}
+
+template <typename Graph>
+void BM_Dfs(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  BasicGraphInfo<Graph> info{.g = Make<Graph>(RandomEdges(vertices), vertices)};
+  for (auto _ : state) {
+    info.timer = 0;
+    info.tIn.assign(vertices, 0);
+    info.tOut.assign(vertices, 0);
+    info.color.assign(vertices, Color::white);
+    info.parent.assign(vertices, -1);
+    Dfs(info, 0);
+    benchmark::DoNotOptimize(info.tOut.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vertices * (kDegree + 1));
+}
+
+template <typename Graph>
+void BM_Bfs(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const g = Make<Graph>(RandomEdges(vertices), vertices);
+  std::vector<int> distance(vertices);
+  std::vector<int> queue(vertices);
+  for (auto _ : state) {
+    std::ranges::fill(distance, -1);
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    distance[0] = 0;
+    queue[tail++] = 0;
+    while (head != tail) {
+      auto const v = queue[head++];
+      for (int to : Neighbors(g, v)) {
+        if (distance[to] == -1) {
+          distance[to] = distance[v] + 1;
+          queue[tail++] = to;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(distance.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vertices * (kDegree + 1));
+}
+
+void BM_BuildLists(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const edges = RandomEdges(vertices);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Lists(edges, vertices).data());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * edges.size()));
+}
+
+void BM_BuildCsr(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const edges = RandomEdges(vertices);
+  for (auto _ : state) {
+    auto const g = CsrGraph::FromEdges(edges, vertices, static_cast<unsigned>(state.range(1)));
+    benchmark::DoNotOptimize(g.Targets().data());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * edges.size()));
+}
+
+using AdjacencyLists = std::vector<std::vector<int>>;
+}  // namespace
+
+BENCHMARK(BM_Dfs<AdjacencyLists>)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK(BM_Dfs<CsrGraph>)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK(BM_Bfs<AdjacencyLists>)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK(BM_Bfs<CsrGraph>)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK(BM_BuildLists)->Arg(1 << 20);
+BENCHMARK(BM_BuildCsr)->Args({1 << 20, 1})->Args({1 << 20, 4})->UseRealTime();
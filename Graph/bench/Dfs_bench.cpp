@@ -0,0 +1,178 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../DfsWorkspace.hpp"
+#include "../GraphInfo.hpp"
+#include <benchmark/benchmark.h>
+
+// The iterative Dfs with byte colors against the recursive one comparing
+// color strings that it replaced, on the same adjacency lists.
+
+namespace {
+struct StringColorInfo {
+  std::vector<std::vector<int>> g;
+  std::vector<int> tIn, tOut;
+  int timer = 0;
+  std::vector<std::string> color;
+  std::vector<int> parent;
+};
+
+void RecursiveDfs(StringColorInfo& info, int v, int p = -1) {
+  info.tIn[v] = info.timer++;
+  info.parent[v] = p;
+  info.color[v] = "grey";
+  for (int to : info.g[v]) {
+    if (info.color[to] == "white") {
+      RecursiveDfs(info, to, v);
+    }
+  }
+  info.tOut[v] = info.timer++;
+  info.color[v] = "black";
+}
+
+constexpr int kDegree = 8;
+
+std::vector<std::vector<int>> RandomLists(int vertices) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<std::vector<int>> g(vertices);
+  for (auto& neighbors : g) {
+    for (int i = 0; i < kDegree; ++i) {
+      neighbors.push_back(vertex(gen));
+    }
+  }
+  return g;
+}
+
+// the baseline recurses once per vertex: sizes stay below the 8 MiB stack
+void BM_RecursiveStringDfs(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  StringColorInfo info{.g = RandomLists(vertices)};
+  for (auto _ : state) {
+    info.timer = 0;
+    info.tIn.assign(vertices, 0);
+    info.tOut.assign(vertices, 0);
+    info.color.assign(vertices, "white");
+    info.parent.assign(vertices, -1);
+    RecursiveDfs(info, 0);
+    benchmark::DoNotOptimize(info.tOut.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vertices);
+}
+
+void BM_IterativeDfs(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  GraphInfo info{.g = RandomLists(vertices)};
+  for (auto _ : state) {
+    info.timer = 0;
+    info.tIn.assign(vertices, 0);
+    info.tOut.assign(vertices, 0);
+    info.color.assign(vertices, Color::white);
+    info.parent.assign(vertices, -1);
+    Dfs(info, 0);
+    benchmark::DoNotOptimize(info.tOut.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vertices);
+}
+
+// a path is the worst case for depth
+void BM_IterativeDfsPath(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  CsrGraphInfo info;
+  std::vector<Edge> edges;
+  for (int v = 0; v + 1 < vertices; ++v) {
+    edges.push_back({v, v + 1});
+  }
+  info.g = CsrGraph::FromEdges(edges, vertices);
+  for (auto _ : state) {
+    info.timer = 0;
+    info.tIn.assign(vertices, 0);
+    info.tOut.assign(vertices, 0);
+    info.color.assign(vertices, Color::white);
+    info.parent.assign(vertices, -1);
+    Dfs(info, 0);
+    benchmark::DoNotOptimize(info.tOut.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vertices);
+}
+
+// a forest from scratch every time: fresh arrays, one Dfs per white vertex
+void BM_ForestFreshArrays(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const g = CsrGraph::FromAdjacency(RandomLists(vertices));
+  for (auto _ : state) {
+    CsrGraphInfo info;
+    info.tIn.resize(vertices);
+    info.tOut.resize(vertices);
+    info.color.assign(vertices, Color::white);
+    info.parent.assign(vertices, -1);
+    info.g = g;
+    for (int v = 0; v < vertices; ++v) {
+      if (info.color[v] == Color::white) {
+        Dfs(info, v);
+      }
+    }
+    benchmark::DoNotOptimize(info.tOut.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vertices);
+}
+
+void BM_ForestWorkspace(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const g = CsrGraph::FromAdjacency(RandomLists(vertices));
+  DfsWorkspace workspace{vertices};
+  for (auto _ : state) {
+    auto const forest = workspace.VisitAll(g);
+    benchmark::DoNotOptimize(forest.tOut.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vertices);
+}
+
+// many short queries on one big graph: what a refill per query costs
+void BM_SmallQueryRefill(benchmark::State& state) {
+  constexpr int kVertices = 1 << 20;
+  std::vector<std::vector<int>> lists(kVertices);
+  for (int v = 0; v + 1 < kVertices; v += 2) {
+    lists[v].push_back(v + 1);
+  }
+  CsrGraphInfo info;
+  info.g = CsrGraph::FromAdjacency(lists);
+  info.tIn.resize(kVertices);
+  info.tOut.resize(kVertices);
+  info.parent.resize(kVertices);
+  int root = 0;
+  for (auto _ : state) {
+    info.timer = 0;
+    info.color.assign(kVertices, Color::white);
+    Dfs(info, root);
+    root = (root + 2) % kVertices;
+    benchmark::DoNotOptimize(info.tOut.data());
+  }
+}
+
+void BM_SmallQueryWorkspace(benchmark::State& state) {
+  constexpr int kVertices = 1 << 20;
+  std::vector<std::vector<int>> lists(kVertices);
+  for (int v = 0; v + 1 < kVertices; v += 2) {
+    lists[v].push_back(v + 1);
+  }
+  auto const g = CsrGraph::FromAdjacency(lists);
+  DfsWorkspace workspace{kVertices};
+  int root = 0;
+  for (auto _ : state) {
+    workspace.Reset();
+    workspace.Visit(g, root);
+    root = (root + 2) % kVertices;
+    benchmark::DoNotOptimize(workspace.Forest().tOut.data());
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_RecursiveStringDfs)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_IterativeDfs)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_IterativeDfsPath)->Arg(1 << 24);
+BENCHMARK(BM_ForestFreshArrays)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_ForestWorkspace)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_SmallQueryRefill);
+BENCHMARK(BM_SmallQueryWorkspace);
@@ -0,0 +1,115 @@
+#include <random>
+#include <vector>
+
+#include "../DfsWorkspace.hpp"
+#include "../DynamicReachability.hpp"
+#include <benchmark/benchmark.h>
+
+// Update throughput: batches of half deletions of existing edges, half
+// random insertions (the argument is the batch size) on a random graph,
+// then reachability from vertex 0 brought up to date incrementally,
+// searched again from scratch, or rebuilt as a CsrGraph and run through
+// Dfs like before. 256K vertices, 2M edges.
+
+namespace {
+constexpr int kVertices = 1 << 18;
+constexpr int kDegree = 8;
+
+class Workload {
+ public:
+  Workload() : m_g(kVertices) {
+    for (std::size_t i = 0; i < std::size_t{kVertices} * kDegree; ++i) {
+      m_edges.push_back({Vertex(), Vertex()});
+      m_g.AddEdge(m_edges.back().from, m_edges.back().to);
+    }
+  }
+
+  DynamicGraph const& Graph() const {
+    return m_g;
+  }
+
+  // the next batch, already applied to the graph
+  void Next(std::size_t size) {
+    m_insertions.resize(size / 2);
+    m_deletions.resize(size - size / 2);
+    for (auto& edge : m_deletions) {
+      auto const at = std::uniform_int_distribution<std::size_t>{0, m_edges.size() - 1}(m_gen);
+      edge = m_edges[at];
+      m_edges[at] = m_edges.back();
+      m_edges.pop_back();
+    }
+    for (auto& edge : m_insertions) {
+      edge = {Vertex(), Vertex()};
+      m_edges.push_back(edge);
+    }
+    m_g.Apply(m_insertions, m_deletions);
+  }
+
+  std::vector<Edge> const& Insertions() const {
+    return m_insertions;
+  }
+
+  std::vector<Edge> const& Deletions() const {
+    return m_deletions;
+  }
+
+ private:
+  int Vertex() {
+    return std::uniform_int_distribution<int>{0, kVertices - 1}(m_gen);
+  }
+
+  std::mt19937 m_gen{42};
+  DynamicGraph m_g;
+  std::vector<Edge> m_edges;
+  std::vector<Edge> m_insertions;
+  std::vector<Edge> m_deletions;
+};
+
+void Report(benchmark::State& state) {
+  state.counters["updates/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * state.range(0)), benchmark::Counter::kIsRate);
+}
+
+void BM_DynamicIncremental(benchmark::State& state) {
+  Workload workload;
+  DynamicReachability reach{workload.Graph(), 0};
+  std::size_t cutOff = 0;
+  for (auto _ : state) {
+    workload.Next(static_cast<std::size_t>(state.range(0)));
+    reach.Update(workload.Insertions(), workload.Deletions());
+    cutOff += reach.LastCutOff();
+  }
+  Report(state);
+  state.counters["cutOff/batch"] =
+      static_cast<double>(cutOff) / static_cast<double>(state.iterations());
+}
+
+void BM_DynamicRecompute(benchmark::State& state) {
+  Workload workload;
+  DynamicReachability reach{workload.Graph(), 0};
+  for (auto _ : state) {
+    workload.Next(static_cast<std::size_t>(state.range(0)));
+    reach.Recompute();
+  }
+  Report(state);
+}
+
+// what a caller had before: a static graph rebuilt and searched per batch
+void BM_DynamicCsrDfs(benchmark::State& state) {
+  Workload workload;
+  DfsWorkspace workspace{kVertices};
+  for (auto _ : state) {
+    workload.Next(static_cast<std::size_t>(state.range(0)));
+    auto const g = workload.Graph().ToCsrGraph();
+    workspace.Reset();
+    workspace.Visit(g, 0);
+    auto const forest = workspace.Forest();
+    benchmark::DoNotOptimize(forest.parent.data());
+  }
+  Report(state);
+}
+}  // namespace
+
+BENCHMARK(BM_DynamicIncremental)->Arg(2)->Arg(64)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DynamicRecompute)->Arg(2)->Arg(64)->Arg(4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DynamicCsrDfs)->Arg(2)->Arg(64)->Arg(4096)->Unit(benchmark::kMicrosecond);
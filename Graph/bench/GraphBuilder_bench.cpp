@@ -0,0 +1,91 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../GraphBuilder.hpp"
+#include "../GraphFile.hpp"
+#include <benchmark/benchmark.h>
+
+// Text edge list in memory -> graph, in edges per second: the from_chars
+// parser with push_back or FromEdges, against GraphBuilder on one thread
+// and on all of them. 1M vertices, 8M edges.
+
+namespace {
+constexpr int kVertices = 1 << 20;
+constexpr std::size_t kEdges = std::size_t{kVertices} * 8;
+
+std::string const& Text() {
+  static std::string const text = [] {
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> vertex{0, kVertices - 1};
+    std::string out;
+    for (std::size_t i = 0; i < kEdges; ++i) {
+      out += std::to_string(vertex(gen)) + ' ' + std::to_string(vertex(gen)) + '\n';
+    }
+    return out;
+  }();
+  return text;
+}
+
+void Report(benchmark::State& state) {
+  state.counters["edges/s"] = benchmark::Counter(static_cast<double>(state.iterations() * kEdges),
+                                                 benchmark::Counter::kIsRate);
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * Text().size()));
+}
+
+void BM_IngestParseLists(benchmark::State& state) {
+  auto const& text = Text();
+  for (auto _ : state) {
+    auto const list = ParseEdgeList(text);
+    std::vector<std::vector<int>> g(static_cast<std::size_t>(list.vertexCount));
+    for (auto [from, to] : list.edges) {
+      g[from].push_back(to);
+    }
+    benchmark::DoNotOptimize(g.data());
+  }
+  Report(state);
+}
+
+void BM_IngestParseCsr(benchmark::State& state) {
+  auto const& text = Text();
+  for (auto _ : state) {
+    auto const list = ParseEdgeList(text);
+    auto g = CsrGraph::FromEdges(list.edges, list.vertexCount);
+    benchmark::DoNotOptimize(&g);
+  }
+  Report(state);
+}
+
+// arg: threads, 0 for DefaultThreads; 16 MB chunks like AddTextStream
+void BM_IngestBuilder(benchmark::State& state) {
+  auto const& text = Text();
+  auto const threads =
+      state.range(0) == 0 ? DefaultThreads() : static_cast<unsigned>(state.range(0));
+  constexpr std::size_t kChunk = std::size_t{1} << 24;
+  for (auto _ : state) {
+    GraphBuilder builder{{.threads = threads}};
+    for (std::size_t i = 0; i < text.size(); i += kChunk) {
+      builder.AddText(std::string_view{text}.substr(i, kChunk));
+    }
+    auto g = builder.Build();
+    benchmark::DoNotOptimize(&g);
+  }
+  Report(state);
+}
+
+void BM_IngestBuilderDedup(benchmark::State& state) {
+  auto const& text = Text();
+  for (auto _ : state) {
+    GraphBuilder builder{{.dropSelfLoops = true, .deduplicate = true}};
+    builder.AddText(text);
+    auto g = builder.Build();
+    benchmark::DoNotOptimize(&g);
+  }
+  Report(state);
+}
+}  // namespace
+
+BENCHMARK(BM_IngestParseLists)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IngestParseCsr)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IngestBuilder)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IngestBuilderDedup)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,120 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../DfsWorkspace.hpp"
+#include "../GraphFile.hpp"
+#include <benchmark/benchmark.h>
+
+// Startup: from a text edge list to a graph ready to traverse, against
+// mapping the binary file. 1M vertices, 8M edges; both files sit in the
+// page cache after the first run, so this is parsing and copying cost,
+// not disk speed.
+
+namespace {
+constexpr int kVertices = 1 << 20;
+constexpr int kDegree = 8;
+
+struct Files {
+  std::filesystem::path text;
+  std::filesystem::path binary;
+
+  Files()
+      : text(std::filesystem::temp_directory_path() / "graph_file_bench.txt"),
+        binary(std::filesystem::temp_directory_path() / "graph_file_bench.csr") {
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> vertex{0, kVertices - 1};
+    std::ofstream out{text};
+    for (std::size_t i = 0; i < std::size_t{kVertices} * kDegree; ++i) {
+      out << vertex(gen) << ' ' << vertex(gen) << '\n';
+    }
+    out.close();
+    ConvertEdgeList(text, binary);
+  }
+
+  ~Files() {
+    std::filesystem::remove(text);
+    std::filesystem::remove(binary);
+  }
+};
+
+Files const& TheFiles() {
+  static Files const files;
+  return files;
+}
+
+std::string ReadAll(std::filesystem::path const& path) {
+  std::ifstream in{path, std::ios::binary};
+  return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+// what startup does today: parse, push_back edge by edge
+void BM_StartupTextLists(benchmark::State& state) {
+  auto const& files = TheFiles();
+  for (auto _ : state) {
+    auto const list = ParseEdgeList(ReadAll(files.text));
+    std::vector<std::vector<int>> g(static_cast<std::size_t>(list.vertexCount));
+    for (auto [from, to] : list.edges) {
+      g[from].push_back(to);
+    }
+    benchmark::DoNotOptimize(g.data());
+  }
+}
+
+void BM_StartupTextCsr(benchmark::State& state) {
+  auto const& files = TheFiles();
+  for (auto _ : state) {
+    auto const list = ParseEdgeList(ReadAll(files.text));
+    auto g = CsrGraph::FromEdges(list.edges, list.vertexCount);
+    benchmark::DoNotOptimize(&g);
+  }
+}
+
+void BM_StartupMapped(benchmark::State& state) {
+  auto const& files = TheFiles();
+  for (auto _ : state) {
+    MappedGraph g{files.binary};
+    benchmark::DoNotOptimize(&g);
+  }
+}
+
+void BM_StartupMappedFullCheck(benchmark::State& state) {
+  auto const& files = TheFiles();
+  for (auto _ : state) {
+    MappedGraph g{files.binary, MappedGraph::Check::full};
+    benchmark::DoNotOptimize(&g);
+  }
+}
+
+// first traversal right after startup, page faults included
+void BM_StartupMappedThenDfs(benchmark::State& state) {
+  auto const& files = TheFiles();
+  DfsWorkspace workspace{kVertices};
+  for (auto _ : state) {
+    MappedGraph g{files.binary};
+    auto const forest = workspace.VisitAll(g);
+    benchmark::DoNotOptimize(forest.tOut.data());
+  }
+}
+
+void BM_StartupCsrThenDfs(benchmark::State& state) {
+  auto const& files = TheFiles();
+  DfsWorkspace workspace{kVertices};
+  for (auto _ : state) {
+    auto const list = ParseEdgeList(ReadAll(files.text));
+    auto const g = CsrGraph::FromEdges(list.edges, list.vertexCount);
+    auto const forest = workspace.VisitAll(g);
+    benchmark::DoNotOptimize(forest.tOut.data());
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_StartupTextLists)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StartupTextCsr)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StartupMapped)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StartupMappedFullCheck)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StartupCsrThenDfs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StartupMappedThenDfs)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,120 @@
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../LcaIndex.hpp"
+#include <benchmark/benchmark.h>
+
+// Build time of the index (from a ready forest) and query throughput on random recursive trees
+// (parent of v uniform below v), one query at a time against the batched
+// API, plus a parent-climbing baseline.
+
+namespace {
+struct Tree {
+  std::vector<int> parent;
+  std::vector<std::vector<int>> children;
+};
+
+Tree RandomTree(int vertices) {
+  std::mt19937 gen{42};
+  Tree tree{std::vector<int>(vertices, -1), std::vector<std::vector<int>>(vertices)};
+  for (int v = 1; v < vertices; ++v) {
+    tree.parent[v] = static_cast<int>(gen() % v);
+    tree.children[tree.parent[v]].push_back(v);
+  }
+  return tree;
+}
+
+std::vector<std::pair<int, int>> RandomQueries(int vertices) {
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<std::pair<int, int>> queries(1 << 16);
+  for (auto& query : queries) {
+    query = {vertex(gen), vertex(gen)};
+  }
+  return queries;
+}
+
+void BM_LcaBuild(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const tree = RandomTree(vertices);
+  DfsWorkspace workspace{vertices};
+  auto const forest = workspace.VisitAll(tree.children);
+  for (auto _ : state) {
+    LcaIndex index{forest};
+    benchmark::DoNotOptimize(&index);
+  }
+  state.SetItemsProcessed(state.iterations() * vertices);
+}
+
+void BM_LcaQuery(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const tree = RandomTree(vertices);
+  DfsWorkspace workspace{vertices};
+  LcaIndex const index{workspace.VisitAll(tree.children)};
+  auto const queries = RandomQueries(vertices);
+  for (auto _ : state) {
+    for (auto [u, v] : queries) {
+      benchmark::DoNotOptimize(index.Lca(u, v));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+}
+
+void BM_LcaBatch(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const tree = RandomTree(vertices);
+  DfsWorkspace workspace{vertices};
+  LcaIndex const index{workspace.VisitAll(tree.children)};
+  auto const queries = RandomQueries(vertices);
+  std::vector<int> out(queries.size());
+  for (auto _ : state) {
+    index.Lca(queries, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+}
+
+void BM_IsAncestor(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const tree = RandomTree(vertices);
+  DfsWorkspace workspace{vertices};
+  LcaIndex const index{workspace.VisitAll(tree.children)};
+  auto const queries = RandomQueries(vertices);
+  for (auto _ : state) {
+    for (auto [u, v] : queries) {
+      benchmark::DoNotOptimize(index.IsAncestor(u, v));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+}
+
+// climb the deeper vertex until the two meet
+void BM_LcaClimbing(benchmark::State& state) {
+  auto const vertices = static_cast<int>(state.range(0));
+  auto const tree = RandomTree(vertices);
+  std::vector<int> depth(vertices, 0);
+  for (int v = 1; v < vertices; ++v) {
+    depth[v] = depth[tree.parent[v]] + 1;
+  }
+  auto const queries = RandomQueries(vertices);
+  for (auto _ : state) {
+    for (auto [u, v] : queries) {
+      while (u != v) {
+        if (depth[u] < depth[v]) {
+          std::swap(u, v);
+        }
+        u = tree.parent[u];
+      }
+      benchmark::DoNotOptimize(u);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+}
+}  // namespace
+
+BENCHMARK(BM_LcaBuild)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_LcaQuery)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_LcaBatch)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_IsAncestor)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_LcaClimbing)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
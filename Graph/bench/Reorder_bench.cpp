@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../Reorder.hpp"
+#include <benchmark/benchmark.h>
+
+// BFS and DFS over the same graph under each ordering. Ids start shuffled,
+// like ingestion order. The edgeGap counter is the mean log2 id distance
+// across an edge, a proxy for cache misses: below ~3 both ends mostly
+// share a line of per-vertex ints. Arguments: shape (0 grid, 1 communities),
+// ordering (0 shuffled, 1 DFS, 2 RCM, 3 degree, 4 community).
+
+namespace {
+constexpr int kSide = 1 << 10;
+constexpr int kCommunity = 64;
+
+CsrGraph Shuffled(std::vector<Edge> edges, int vertices) {
+  std::vector<int> ids(static_cast<std::size_t>(vertices));
+  std::iota(ids.begin(), ids.end(), 0);
+  std::ranges::shuffle(ids, std::mt19937{42});
+  for (auto& edge : edges) {
+    edge = {ids[edge.from], ids[edge.to]};
+  }
+  return CsrGraph::FromEdges(edges, vertices);
+}
+
+// undirected 4-neighbour grid, a road-network stand-in
+CsrGraph Grid() {
+  std::vector<Edge> edges;
+  for (int row = 0; row < kSide; ++row) {
+    for (int column = 0; column < kSide; ++column) {
+      auto const v = row * kSide + column;
+      if (column + 1 < kSide) {
+        edges.push_back({v, v + 1});
+        edges.push_back({v + 1, v});
+      }
+      if (row + 1 < kSide) {
+        edges.push_back({v, v + kSide});
+        edges.push_back({v + kSide, v});
+      }
+    }
+  }
+  return Shuffled(std::move(edges), kSide * kSide);
+}
+
+// 8 edges inside the own community of 64 per vertex, 1 to anywhere
+CsrGraph Communities() {
+  constexpr int kVertices = kSide * kSide;
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<int> member{0, kCommunity - 1};
+  std::uniform_int_distribution<int> anywhere{0, kVertices - 1};
+  std::vector<Edge> edges;
+  for (int v = 0; v < kVertices; ++v) {
+    for (int i = 0; i < 8; ++i) {
+      edges.push_back({v, v / kCommunity * kCommunity + member(gen)});
+    }
+    edges.push_back({v, anywhere(gen)});
+  }
+  return Shuffled(std::move(edges), kVertices);
+}
+
+Permutation Order(CsrGraph const& g, int ordering) {
+  switch (ordering) {
+    case 1:
+      return DfsOrder(g);
+    case 2:
+      return ReverseCuthillMcKee(g);
+    case 3:
+      return DegreeOrder(g);
+    case 4:
+      return CommunityOrder(g);
+    default:
+      return Permutation::Identity(g.VertexCount());
+  }
+}
+
+CsrGraph const& Graph(int shape, int ordering) {
+  static std::vector<CsrGraph> cache(10);
+  auto& g = cache[static_cast<std::size_t>(shape * 5 + ordering)];
+  if (g.VertexCount() == 0) {
+    static auto const grid = Grid();
+    static auto const communities = Communities();
+    auto const& base = shape == 0 ? grid : communities;
+    g = Relabel(base, Order(base, ordering));
+  }
+  return g;
+}
+
+double EdgeGap(CsrGraph const& g) {
+  double sum = 0;
+  for (int v = 0; v < g.VertexCount(); ++v) {
+    for (int w : g.Neighbors(v)) {
+      sum += std::log2(std::abs(v - w) + 1.0);
+    }
+  }
+  return sum / static_cast<double>(g.EdgeCount());
+}
+
+void BM_BfsAfterReorder(benchmark::State& state) {
+  auto const& g = Graph(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+  std::vector<int> distance(static_cast<std::size_t>(g.VertexCount()));
+  std::vector<int> queue(distance.size());
+  for (auto _ : state) {
+    std::ranges::fill(distance, -1);
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    distance[0] = 0;
+    queue[tail++] = 0;
+    while (head != tail) {
+      auto const v = queue[head++];
+      for (int to : g.Neighbors(v)) {
+        if (distance[to] == -1) {
+          distance[to] = distance[v] + 1;
+          queue[tail++] = to;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(distance.data());
+  }
+  state.counters["edgeGap"] = EdgeGap(g);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.EdgeCount()));
+}
+
+void BM_DfsAfterReorder(benchmark::State& state) {
+  auto const& g = Graph(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+  DfsWorkspace workspace{g.VertexCount()};
+  for (auto _ : state) {
+    auto const forest = workspace.VisitAll(g);
+    benchmark::DoNotOptimize(forest.tOut.data());
+  }
+  state.counters["edgeGap"] = EdgeGap(g);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.EdgeCount()));
+}
+
+// what computing the ordering and relabeling costs
+void BM_Reorder(benchmark::State& state) {
+  auto const& base = Graph(static_cast<int>(state.range(0)), 0);
+  for (auto _ : state) {
+    auto g = Relabel(base, Order(base, static_cast<int>(state.range(1))));
+    benchmark::DoNotOptimize(&g);
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_BfsAfterReorder)->ArgsProduct({{0, 1}, {0, 1, 2, 3, 4}});
+BENCHMARK(BM_DfsAfterReorder)->ArgsProduct({{0, 1}, {0, 1, 2, 3, 4}});
+BENCHMARK(BM_Reorder)->ArgsProduct({{0, 1}, {1, 2, 3, 4}})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,101 @@
+#include <random>
+#include <vector>
+
+#include "../Cycles.hpp"
+#include "../Scc.hpp"
+#include <benchmark/benchmark.h>
+
+// Sequential Tarjan against ParallelScc (thread count is the second
+// argument) on two shapes: a random graph with one giant component, and a
+// dependency-like graph, mostly acyclic with a few short cycles.
+
+namespace {
+constexpr int kVertices = 1 << 20;
+constexpr int kDegree = 4;
+
+CsrGraph RandomGraph() {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> vertex{0, kVertices - 1};
+  std::vector<Edge> edges(static_cast<std::size_t>(kVertices) * kDegree);
+  for (auto& edge : edges) {
+    edge = {vertex(gen), vertex(gen)};
+  }
+  return CsrGraph::FromEdges(edges, kVertices);
+}
+
+// edges to higher ids within a window, one in 1000 points back
+CsrGraph DependencyGraph() {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> offset{1, 64};
+  std::uniform_int_distribution<int> backwards{0, 999};
+  std::vector<Edge> edges;
+  edges.reserve(static_cast<std::size_t>(kVertices) * kDegree);
+  for (int v = 0; v < kVertices; ++v) {
+    for (int i = 0; i < kDegree; ++i) {
+      auto const step = offset(gen);
+      auto const to = backwards(gen) == 0 ? v - step : v + step;
+      if (to >= 0 && to < kVertices) {
+        edges.push_back({v, to});
+      }
+    }
+  }
+  return CsrGraph::FromEdges(edges, kVertices);
+}
+
+CsrGraph const& Shape(int shape) {
+  static auto const random = RandomGraph();
+  static auto const dependency = DependencyGraph();
+  return shape == 0 ? random : dependency;
+}
+
+void BM_TarjanScc(benchmark::State& state) {
+  auto const& g = Shape(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    auto scc = TarjanScc(g);
+    benchmark::DoNotOptimize(scc.component.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.EdgeCount()));
+}
+
+void BM_ParallelScc(benchmark::State& state) {
+  auto const& g = Shape(static_cast<int>(state.range(0)));
+  auto const reverse = g.Transposed();
+  for (auto _ : state) {
+    auto scc = ParallelScc(g, reverse, static_cast<unsigned>(state.range(1)));
+    benchmark::DoNotOptimize(scc.component.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.EdgeCount()));
+}
+
+void BM_TopologicalOrder(benchmark::State& state) {
+  std::vector<Edge> edges;
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> offset{1, 64};
+  for (int v = 0; v < kVertices; ++v) {
+    for (int i = 0; i < kDegree; ++i) {
+      if (auto const to = v + offset(gen); to < kVertices) {
+        edges.push_back({v, to});
+      }
+    }
+  }
+  auto const g = CsrGraph::FromEdges(edges, kVertices);
+  DfsWorkspace workspace{kVertices};
+  for (auto _ : state) {
+    auto order = TopologicalOrder(g, workspace);
+    benchmark::DoNotOptimize(order->data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.EdgeCount()));
+}
+
+void Shapes(benchmark::internal::Benchmark* bench) {
+  for (int shape : {0, 1}) {
+    for (int threads = 1; threads <= static_cast<int>(DefaultThreads()); threads *= 2) {
+      bench->Args({shape, threads});
+    }
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_TarjanScc)->Arg(0)->Arg(1);
+BENCHMARK(BM_ParallelScc)->Apply(Shapes)->UseRealTime();
+BENCHMARK(BM_TopologicalOrder);
@@ -0,0 +1,129 @@
+#include <climits>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "../Bfs.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+std::vector<int> SequentialDistances(CsrGraph const& g, int source) {
+  std::vector<int> distance(static_cast<std::size_t>(g.VertexCount()), -1);
+  std::queue<int> queue;
+  distance[source] = 0;
+  queue.push(source);
+  while (!queue.empty()) {
+    auto const v = queue.front();
+    queue.pop();
+    for (int to : g.Neighbors(v)) {
+      if (distance[to] == -1) {
+        distance[to] = distance[v] + 1;
+        queue.push(to);
+      }
+    }
+  }
+  return distance;
+}
+
+CsrGraph RandomGraph(int vertices, int degree, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<Edge> edges(static_cast<std::size_t>(vertices) * degree);
+  for (auto& edge : edges) {
+    edge = {vertex(gen), vertex(gen)};
+  }
+  return CsrGraph::FromEdges(edges, vertices);
+}
+
+bool HasEdge(CsrGraph const& g, int from, int to) {
+  return std::ranges::find(g.Neighbors(from), to) != g.Neighbors(from).end();
+}
+
+// exact distances, and every parent is one level up with an edge to v
+void ExpectValid(CsrGraph const& g, int source, BfsInfo const& info) {
+  ASSERT_EQ(info.distance, SequentialDistances(g, source));
+  ASSERT_EQ(info.parent[source], -1);
+  for (int v = 0; v < g.VertexCount(); ++v) {
+    if (v == source || info.distance[v] == -1) {
+      ASSERT_EQ(info.parent[v], -1) << v;
+      continue;
+    }
+    auto const p = info.parent[v];
+    ASSERT_NE(p, -1) << v;
+    ASSERT_EQ(info.distance[p] + 1, info.distance[v]) << v;
+    ASSERT_TRUE(HasEdge(g, p, v)) << p << " -> " << v;
+  }
+}
+
+// alpha = 1 practically never goes bottom-up, INT_MAX right away
+constexpr BfsOptions kTopDown{.threads = 4, .alpha = 1, .beta = 18};
+constexpr BfsOptions kBottomUp{.threads = 4, .alpha = INT_MAX, .beta = INT_MAX};
+}  // namespace
+
+TEST(BfsTest, SingleVertex) {
+  auto const g = CsrGraph::FromAdjacency({{}});
+  auto const info = Bfs(g, g.Transposed(), 0);
+  ASSERT_EQ(info.distance, std::vector<int>{0});
+  ASSERT_EQ(info.parent, std::vector<int>{-1});
+}
+
+TEST(BfsTest, PathAndUnreachable) {
+  // 0 -> 1 -> 2, 3 -> 0
+  auto const g = CsrGraph::FromAdjacency({{1}, {2}, {}, {0}});
+  auto const info = Bfs(g, g.Transposed(), 0);
+  ASSERT_EQ(info.distance, (std::vector<int>{0, 1, 2, -1}));
+  ASSERT_EQ(info.parent, (std::vector<int>{-1, 0, 1, -1}));
+}
+
+TEST(BfsTest, DirectedRandomGraphAllModes) {
+  auto const g = RandomGraph(50000, 6, 1);
+  auto const reverse = g.Transposed();
+  for (auto const& options : {BfsOptions{}, kTopDown, kBottomUp, BfsOptions{.threads = 3}}) {
+    ExpectValid(g, 7, Bfs(g, reverse, 7, options));
+  }
+}
+
+TEST(BfsTest, SparseGraphLeavesVerticesUnreached) {
+  auto const g = RandomGraph(20000, 1, 2);
+  auto const reverse = g.Transposed();
+  for (auto const& options : {BfsOptions{}, kTopDown, kBottomUp}) {
+    ExpectValid(g, 0, Bfs(g, reverse, 0, options));
+  }
+}
+
+TEST(BfsTest, UndirectedGridSwitchesBackAndForth) {
+  constexpr int kSide = 300;
+  std::vector<Edge> edges;
+  auto const id = [](int row, int column) { return row * kSide + column; };
+  for (int row = 0; row < kSide; ++row) {
+    for (int column = 0; column < kSide; ++column) {
+      if (column + 1 < kSide) {
+        edges.push_back({id(row, column), id(row, column + 1)});
+        edges.push_back({id(row, column + 1), id(row, column)});
+      }
+      if (row + 1 < kSide) {
+        edges.push_back({id(row, column), id(row + 1, column)});
+        edges.push_back({id(row + 1, column), id(row, column)});
+      }
+    }
+  }
+  auto const g = CsrGraph::FromEdges(edges, kSide * kSide);
+  auto const info = BfsUndirected(g, id(kSide / 2, kSide / 2), {.threads = 4, .alpha = 2, .beta = 4});
+  ExpectValid(g, id(kSide / 2, kSide / 2), info);
+  ASSERT_EQ(info.distance[id(0, 0)], kSide / 2 * 2);
+}
+
+TEST(BfsTest, TransposedReversesEveryEdge) {
+  auto const g = CsrGraph::FromAdjacency({{1, 2}, {2}, {0}});
+  auto const t = g.Transposed();
+  ASSERT_EQ(t.EdgeCount(), g.EdgeCount());
+  ASSERT_TRUE(std::ranges::equal(t.Neighbors(0), std::vector<int>{2}));
+  ASSERT_TRUE(std::ranges::equal(t.Neighbors(1), std::vector<int>{0}));
+  ASSERT_TRUE(std::ranges::equal(t.Neighbors(2), std::vector<int>{0, 1}));
+}
+
+TEST(BfsTest, RejectsBadArguments) {
+  auto const g = CsrGraph::FromAdjacency({{1}, {}});
+  ASSERT_THROW(Bfs(g, g.Transposed(), 2), std::out_of_range);
+  ASSERT_THROW(Bfs(g, CsrGraph::FromAdjacency({{}, {}}), 0), std::invalid_argument);
+}
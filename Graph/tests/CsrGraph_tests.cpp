@@ -0,0 +1,93 @@
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../CsrGraph.hpp"
+#include "../GraphInfo.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+std::vector<Edge> RandomEdges(int vertices, std::size_t count, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<Edge> edges(count);
+  for (auto& edge : edges) {
+    edge = {vertex(gen), vertex(gen)};
+  }
+  return edges;
+}
+
+std::vector<std::vector<int>> PushBack(std::vector<Edge> const& edges, int vertices) {
+  std::vector<std::vector<int>> g(vertices);
+  for (auto [from, to] : edges) {
+    g[from].push_back(to);
+  }
+  return g;
+}
+
+template <typename Graph>
+BasicGraphInfo<Graph> Prepared(Graph g) {
+  auto const n = static_cast<std::size_t>(VertexCount(g));
+  BasicGraphInfo<Graph> info{.g = std::move(g)};
+  info.tIn.resize(n);
+  info.tOut.resize(n);
+  info.color.assign(n, Color::white);
+  info.parent.assign(n, -1);
+  return info;
+}
+}  // namespace
+
+TEST(CsrGraphTest, EmptyGraph) {
+  CsrGraph g;
+  ASSERT_EQ(g.VertexCount(), 0);
+  ASSERT_EQ(g.EdgeCount(), 0);
+
+  auto const isolated = CsrGraph::FromEdges({}, 3);
+  ASSERT_EQ(isolated.VertexCount(), 3);
+  ASSERT_TRUE(isolated.Neighbors(1).empty());
+}
+
+TEST(CsrGraphTest, KeepsInputOrderPerVertex) {
+  std::vector<Edge> const edges{{2, 0}, {0, 3}, {2, 1}, {0, 1}, {0, 0}, {0, 1}};
+  auto const g = CsrGraph::FromEdges(edges, 4);
+
+  ASSERT_EQ(g.EdgeCount(), 6);
+  ASSERT_EQ(std::vector(g.Neighbors(0).begin(), g.Neighbors(0).end()),
+            (std::vector<int>{3, 1, 0, 1}));
+  ASSERT_TRUE(g.Neighbors(1).empty());
+  ASSERT_EQ(std::vector(g.Neighbors(2).begin(), g.Neighbors(2).end()),
+            (std::vector<int>{0, 1}));
+  ASSERT_EQ(g.Degree(3), 0);
+}
+
+TEST(CsrGraphTest, ParallelBuildMatchesPushBack) {
+  constexpr int kVertices = 5000;
+  auto const edges = RandomEdges(kVertices, 400000, 7);
+  auto const expected = CsrGraph::FromAdjacency(PushBack(edges, kVertices));
+
+  for (unsigned threads : {1u, 2u, 3u, 8u}) {
+    auto const g = CsrGraph::FromEdges(edges, kVertices, threads);
+    ASSERT_TRUE(std::ranges::equal(g.Offsets(), expected.Offsets())) << threads;
+    ASSERT_TRUE(std::ranges::equal(g.Targets(), expected.Targets())) << threads;
+  }
+}
+
+TEST(CsrGraphTest, RejectsBadEndpoints) {
+  std::vector<Edge> const edges{{0, 1}, {1, 5}};
+  ASSERT_THROW(static_cast<void>(CsrGraph::FromEdges(edges, 3)), std::out_of_range);
+  ASSERT_THROW(CsrGraph({0, 2}, {1}), std::invalid_argument);
+}
+
+TEST(CsrGraphTest, DfsMatchesVectorLayout) {
+  constexpr int kVertices = 2000;
+  auto const edges = RandomEdges(kVertices, 6000, 11);
+  auto lists = Prepared(PushBack(edges, kVertices));
+  auto csr = Prepared(CsrGraph::FromEdges(edges, kVertices));
+
+  Dfs(lists, 0);
+  Dfs(csr, 0);
+  ASSERT_EQ(lists.tIn, csr.tIn);
+  ASSERT_EQ(lists.tOut, csr.tOut);
+  ASSERT_EQ(lists.parent, csr.parent);
+  ASSERT_EQ(lists.color, csr.color);
+}
@@ -0,0 +1,81 @@
+#include <vector>
+
+#include "../Cycles.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+bool IsCycle(std::vector<std::vector<int>> const& g, std::vector<int> const& cycle) {
+  for (std::size_t i = 0; i < cycle.size(); ++i) {
+    auto const& neighbors = g[cycle[i]];
+    if (std::ranges::find(neighbors, cycle[(i + 1) % cycle.size()]) == neighbors.end()) {
+      return false;
+    }
+  }
+  return !cycle.empty();
+}
+}  // namespace
+
+TEST(CyclesTest, ClassifiesEveryKind) {
+  // 0 -> 1 -> 2 -> 0 (back), 0 -> 2 (forward), 3 -> 1 (cross)
+  std::vector<std::vector<int>> g{{1, 2}, {2}, {0}, {1}};
+  DfsWorkspace workspace{4};
+  auto const forest = workspace.VisitAll(g);
+
+  ASSERT_EQ(ClassifyEdge(forest, 0, 1), EdgeKind::tree);
+  ASSERT_EQ(ClassifyEdge(forest, 1, 2), EdgeKind::tree);
+  ASSERT_EQ(ClassifyEdge(forest, 2, 0), EdgeKind::back);
+  ASSERT_EQ(ClassifyEdge(forest, 0, 2), EdgeKind::forward);
+  ASSERT_EQ(ClassifyEdge(forest, 3, 1), EdgeKind::cross);
+}
+
+TEST(CyclesTest, SelfLoopIsBackEdge) {
+  std::vector<std::vector<int>> g{{0, 1}, {}};
+  DfsWorkspace workspace{2};
+  auto const forest = workspace.VisitAll(g);
+  ASSERT_EQ(ClassifyEdge(forest, 0, 0), EdgeKind::back);
+  ASSERT_EQ(FindCycle(g), std::vector<int>{0});
+}
+
+TEST(CyclesTest, FindCycleReturnsACycle) {
+  // the cycle 2 -> 3 -> 4 -> 2 behind a tail
+  std::vector<std::vector<int>> g{{1}, {2}, {3}, {4, 5}, {2}, {}};
+  auto const cycle = FindCycle(g);
+  ASSERT_EQ(cycle, (std::vector<int>{2, 3, 4}));
+  ASSERT_TRUE(IsCycle(g, cycle));
+}
+
+TEST(CyclesTest, AcyclicGraphHasNoCycle) {
+  std::vector<std::vector<int>> g{{1, 2}, {3}, {3}, {}};
+  ASSERT_TRUE(FindCycle(g).empty());
+}
+
+TEST(CyclesTest, TopologicalOrderPutsEdgesForward) {
+  std::vector<std::vector<int>> g{{2}, {2, 3}, {4}, {4}, {}, {0}};
+  auto const order = TopologicalOrder(g);
+  ASSERT_TRUE(order.has_value());
+  ASSERT_EQ(order->size(), g.size());
+  std::vector<int> position(g.size());
+  for (std::size_t i = 0; i < order->size(); ++i) {
+    position[(*order)[i]] = static_cast<int>(i);
+  }
+  for (int u = 0; u < static_cast<int>(g.size()); ++u) {
+    for (int v : g[u]) {
+      ASSERT_LT(position[u], position[v]) << u << " -> " << v;
+    }
+  }
+}
+
+TEST(CyclesTest, TopologicalOrderRejectsCycles) {
+  std::vector<std::vector<int>> g{{1}, {2}, {1}};
+  ASSERT_FALSE(TopologicalOrder(g).has_value());
+  ASSERT_FALSE(TopologicalOrder(CsrGraph::FromAdjacency(g)).has_value());
+}
+
+TEST(CyclesTest, WorkspaceIsReused) {
+  std::vector<std::vector<int>> dag{{1}, {}};
+  std::vector<std::vector<int>> cyclic{{1}, {0}};
+  DfsWorkspace workspace{2};
+  ASSERT_TRUE(TopologicalOrder(dag, workspace).has_value());
+  ASSERT_EQ(FindCycle(cyclic, workspace), (std::vector<int>{0, 1}));
+  ASSERT_TRUE(TopologicalOrder(dag, workspace).has_value());
+}
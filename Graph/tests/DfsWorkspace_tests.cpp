@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "../DfsWorkspace.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+
+// Out of line, so the compiler doesn't pair malloc/free with the new and
+// delete expressions it inlines them into.
+[[gnu::noinline]] void* CountedAllocate(std::size_t size, std::size_t alignment) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  // aligned_alloc wants a multiple of the alignment
+  auto const bytes = (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+  auto const ptr = alignment <= alignof(std::max_align_t) ? std::malloc(bytes)
+                                                          : std::aligned_alloc(alignment, bytes);
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return ptr;
+}
+
+[[gnu::noinline]] void CountedFree(void* ptr) noexcept {
+  std::free(ptr);
+}
+}  // namespace
+
+// counts every allocation of this binary: scalar, array, aligned and
+// nothrow forms, sanitizer runtimes replace each one of them too
+void* operator new(std::size_t size) {
+  return CountedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+  return CountedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return CountedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return CountedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+  try {
+    return operator new(size);
+  } catch (std::bad_alloc const&) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept {
+  try {
+    return operator new[](size);
+  } catch (std::bad_alloc const&) {
+    return nullptr;
+  }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept {
+  try {
+    return operator new(size, alignment);
+  } catch (std::bad_alloc const&) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     std::nothrow_t const&) noexcept {
+  try {
+    return operator new[](size, alignment);
+  } catch (std::bad_alloc const&) {
+    return nullptr;
+  }
+}
+
+void operator delete(void* ptr) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete(void* ptr, std::nothrow_t const&) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, std::nothrow_t const&) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, std::nothrow_t const&) noexcept {
+  CountedFree(ptr);
+}
+
+namespace {
+// 0 -> 1 -> 2, 3 -> 4, 5 alone, 6 -> 0
+std::vector<std::vector<int>> ThreeComponents() {
+  return {{1}, {2}, {}, {4}, {}, {}, {0}};
+}
+}  // namespace
+
+TEST(DfsWorkspaceTest, VisitAllCoversEveryComponent) {
+  auto const g = ThreeComponents();
+  DfsWorkspace workspace{VertexCount(g)};
+
+  auto const forest = workspace.VisitAll(g);
+
+  ASSERT_EQ(std::vector<int>(forest.roots.begin(), forest.roots.end()),
+            (std::vector<int>{0, 3, 5, 6}));
+  ASSERT_EQ(std::vector<int>(forest.parent.begin(), forest.parent.end()),
+            (std::vector<int>{-1, 0, 1, -1, 3, -1, -1}));
+  ASSERT_EQ(workspace.Timer(), 14);
+  for (int v = 0; v < VertexCount(g); ++v) {
+    ASSERT_EQ(workspace.ColorOf(v), Color::black);
+    ASSERT_LT(forest.tIn[v], forest.tOut[v]);
+  }
+  // trees are nested intervals, one after the other
+  ASSERT_EQ(forest.tIn[0], 0);
+  ASSERT_EQ(forest.tOut[0], 5);
+  ASSERT_EQ(forest.tIn[3], 6);
+  ASSERT_EQ(forest.tIn[6], 12);
+}
+
+TEST(DfsWorkspaceTest, MatchesGraphInfoDfsOnOneTree) {
+  std::vector<std::vector<int>> g{{1, 2}, {3}, {3, 4}, {}, {0}};
+  GraphInfo info;
+  info.g = g;
+  info.tIn.resize(5);
+  info.tOut.resize(5);
+  info.color.assign(5, Color::white);
+  info.parent.assign(5, -1);
+  Dfs(info, 0);
+
+  DfsWorkspace workspace{5};
+  workspace.Visit(g, 0);
+  auto const forest = workspace.Forest();
+
+  for (int v = 0; v < 5; ++v) {
+    ASSERT_EQ(forest.tIn[v], info.tIn[v]);
+    ASSERT_EQ(forest.tOut[v], info.tOut[v]);
+    ASSERT_EQ(forest.parent[v], info.parent[v]);
+  }
+}
+
+TEST(DfsWorkspaceTest, ResetForgetsVisits) {
+  auto const g = ThreeComponents();
+  DfsWorkspace workspace{VertexCount(g)};
+
+  workspace.Visit(g, 3);
+  ASSERT_TRUE(workspace.Visited(4));
+  ASSERT_FALSE(workspace.Visited(0));
+
+  workspace.Reset();
+  for (int v = 0; v < VertexCount(g); ++v) {
+    ASSERT_EQ(workspace.ColorOf(v), Color::white);
+  }
+  ASSERT_EQ(workspace.Timer(), 0);
+  ASSERT_TRUE(workspace.Forest().roots.empty());
+
+  workspace.Visit(g, 6);
+  ASSERT_EQ(workspace.Forest().parent[2], 1);
+  ASSERT_FALSE(workspace.Visited(3));
+}
+
+TEST(DfsWorkspaceTest, VisitFromSkipsReachedSources) {
+  auto const g = ThreeComponents();
+  DfsWorkspace workspace{VertexCount(g)};
+  std::vector<int> const sources{1, 0, 6, 2};
+
+  auto const forest = workspace.VisitFrom(g, sources);
+
+  ASSERT_EQ(std::vector<int>(forest.roots.begin(), forest.roots.end()),
+            (std::vector<int>{1, 0, 6}));
+  ASSERT_EQ(forest.parent[2], 1);
+  ASSERT_EQ(forest.parent[1], -1);
+  ASSERT_FALSE(workspace.Visited(3));
+  ASSERT_FALSE(workspace.Visited(5));
+}
+
+TEST(DfsWorkspaceTest, WorksOnCsrGraph) {
+  auto const lists = ThreeComponents();
+  auto const csr = CsrGraph::FromAdjacency(lists);
+  DfsWorkspace fromLists{VertexCount(lists)};
+  DfsWorkspace fromCsr{VertexCount(csr)};
+
+  auto const expected = fromLists.VisitAll(lists);
+  auto const actual = fromCsr.VisitAll(csr);
+
+  ASSERT_TRUE(std::ranges::equal(expected.roots, actual.roots));
+  ASSERT_TRUE(std::ranges::equal(expected.parent, actual.parent));
+  ASSERT_TRUE(std::ranges::equal(expected.tIn, actual.tIn));
+  ASSERT_TRUE(std::ranges::equal(expected.tOut, actual.tOut));
+}
+
+// the steady state check below means nothing if some form goes uncounted
+TEST(DfsWorkspaceTest, CounterSeesEveryAllocationForm) {
+  struct alignas(64) Overaligned {
+    char bytes[64];
+  };
+  auto const before = g_allocations.load();
+  delete new int{1};
+  delete[] new int[4];
+  delete new Overaligned{};
+  delete[] new Overaligned[2];
+  delete new (std::nothrow) int{2};
+  operator delete[](operator new[](8, std::align_val_t{64}, std::nothrow), std::align_val_t{64});
+  std::vector<int> vector(16);
+  ASSERT_EQ(g_allocations.load(), before + 7);
+}
+
+TEST(DfsWorkspaceTest, SteadyStateDoesNotAllocate) {
+  constexpr int kVertices = 1 << 12;
+  std::vector<std::vector<int>> g(kVertices);
+  for (int v = 0; v + 1 < kVertices; ++v) {
+    // long paths and many components
+    if (v % 100 != 99) {
+      g[v].push_back(v + 1);
+    }
+  }
+  auto const csr = CsrGraph::FromAdjacency(g);
+  DfsWorkspace workspace{kVertices};
+
+  auto const before = g_allocations.load();
+  for (int i = 0; i < 1000; ++i) {
+    workspace.VisitAll(csr);
+    workspace.Reset();
+    workspace.Visit(g, i % kVertices);
+  }
+  ASSERT_EQ(g_allocations.load(), before);
+  ASSERT_EQ(workspace.Forest().roots.size(), 1);
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../DynamicGraph.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+std::vector<int> Out(DynamicGraph const& g, int v) {
+  std::vector<int> out;
+  g.ForEachNeighbor(v, [&](int w) { out.push_back(w); });
+  return out;
+}
+
+std::vector<int> In(DynamicGraph const& g, int v) {
+  std::vector<int> in;
+  g.ForEachInNeighbor(v, [&](int u) { in.push_back(u); });
+  return in;
+}
+
+// every list of g against adjacency lists kept by hand
+void ExpectSame(DynamicGraph const& g, std::vector<std::vector<int>> const& expected) {
+  std::vector<std::vector<int>> in(expected.size());
+  std::size_t edges = 0;
+  for (std::size_t v = 0; v < expected.size(); ++v) {
+    ASSERT_EQ(Out(g, static_cast<int>(v)), expected[v]) << v;
+    for (int w : expected[v]) {
+      in[w].push_back(static_cast<int>(v));
+    }
+    edges += expected[v].size();
+  }
+  for (std::size_t v = 0; v < expected.size(); ++v) {
+    auto actual = In(g, static_cast<int>(v));
+    std::ranges::sort(actual);
+    ASSERT_EQ(actual, in[v]) << v;
+    ASSERT_EQ(g.InDegree(static_cast<int>(v)), in[v].size());
+  }
+  ASSERT_EQ(g.EdgeCount(), edges);
+}
+}  // namespace
+
+TEST(DynamicGraphTest, AddsAndRemovesEdges) {
+  DynamicGraph g{3};
+  g.AddEdge(0, 1);
+  g.AddEdge(0, 0);
+  g.AddEdge(0, 1);  // Multiple edges
+  g.AddEdge(1, 2);
+  ASSERT_EQ(g.EdgeCount(), 4u);
+  ASSERT_EQ(Out(g, 0), (std::vector<int>{1, 0, 1}));
+  ASSERT_TRUE(g.HasEdge(0, 1));
+  ASSERT_FALSE(g.HasEdge(2, 1));
+
+  ASSERT_TRUE(g.RemoveEdge(0, 1));
+  ASSERT_TRUE(g.HasEdge(0, 1));
+  ASSERT_TRUE(g.RemoveEdge(0, 1));
+  ASSERT_FALSE(g.HasEdge(0, 1));
+  ASSERT_FALSE(g.RemoveEdge(0, 1));
+  ASSERT_EQ(Out(g, 0), std::vector<int>{0});
+  ASSERT_EQ(In(g, 1), std::vector<int>{});
+  ASSERT_EQ(g.Degree(0), 1u);
+  ASSERT_EQ(g.EdgeCount(), 2u);
+  ASSERT_EQ(g.TombstoneCount(), 4u);
+  g.Compact();
+  ASSERT_EQ(g.TombstoneCount(), 0u);
+  ASSERT_EQ(Out(g, 0), std::vector<int>{0});
+
+  ASSERT_THROW(g.AddEdge(0, 3), std::out_of_range);
+  ASSERT_THROW(g.RemoveEdge(-1, 0), std::out_of_range);
+  ASSERT_THROW(DynamicGraph{-1}, std::out_of_range);
+}
+
+TEST(DynamicGraphTest, LongListsSpanBlocks) {
+  DynamicGraph g{100};
+  std::vector<std::vector<int>> expected(100);
+  for (int w = 0; w < 100; ++w) {
+    g.AddEdge(7, w);
+    expected[7].push_back(w);
+  }
+  // every third, so tombstones pile up and trigger compaction
+  for (int w = 0; w < 100; w += 3) {
+    ASSERT_TRUE(g.RemoveEdge(7, w));
+    std::erase(expected[7], w);
+  }
+  ExpectSame(g, expected);
+  for (int w = 0; w < 100; ++w) {
+    g.RemoveEdge(7, w);
+  }
+  ASSERT_EQ(g.EdgeCount(), 0u);
+  g.AddEdge(7, 5);
+  ASSERT_EQ(Out(g, 7), std::vector<int>{5});
+}
+
+TEST(DynamicGraphTest, RandomBatchesMatchLists) {
+  constexpr int kVertices = 50;
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<int> vertex{0, kVertices - 1};
+  DynamicGraph g{kVertices};
+  std::vector<std::vector<int>> expected(kVertices);
+  for (int round = 0; round < 200; ++round) {
+    std::vector<Edge> insertions(20);
+    std::vector<Edge> deletions(15);
+    for (auto& edge : insertions) {
+      edge = {vertex(gen), vertex(gen) % 10};
+    }
+    for (auto& edge : deletions) {
+      edge = {vertex(gen), vertex(gen) % 10};
+    }
+    g.Apply(insertions, deletions);
+    for (auto [from, to] : deletions) {
+      auto& list = expected[from];
+      if (auto it = std::ranges::find(list, to); it != list.end()) {
+        list.erase(it);
+      }
+    }
+    for (auto [from, to] : insertions) {
+      expected[from].push_back(to);
+    }
+    ExpectSame(g, expected);
+    if (round % 50 == 0) {
+      g.Compact();
+      ASSERT_EQ(g.TombstoneCount(), 0u);
+      ExpectSame(g, expected);
+    }
+  }
+  auto const csr = g.ToCsrGraph();
+  ASSERT_EQ(csr.EdgeCount(), g.EdgeCount());
+  for (int v = 0; v < kVertices; ++v) {
+    ASSERT_TRUE(std::ranges::equal(csr.Neighbors(v), expected[v]));
+  }
+}
+
+TEST(DynamicGraphTest, BadBatchLeavesGraphAlone) {
+  DynamicGraph g{2};
+  g.AddEdge(0, 1);
+  std::vector<Edge> const insertions{{1, 0}, {1, 2}};
+  std::vector<Edge> const deletions{{0, 1}};
+  ASSERT_THROW(g.Apply(insertions, deletions), std::out_of_range);
+  ASSERT_EQ(g.EdgeCount(), 1u);
+  ASSERT_TRUE(g.HasEdge(0, 1));
+}
+
+TEST(DynamicGraphTest, FromCsrGraph) {
+  auto const csr = CsrGraph::FromAdjacency({{1, 2}, {2}, {0, 0}});
+  DynamicGraph const g{csr};
+  ASSERT_EQ(g.VertexCount(), 3);
+  ExpectSame(g, {{1, 2}, {2}, {0, 0}});
+}
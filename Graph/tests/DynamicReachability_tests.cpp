@@ -0,0 +1,135 @@
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../Bfs.hpp"
+#include "../DynamicReachability.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+// reached set against a search from scratch, and every parent chain an
+// existing path to the root
+void ExpectValid(DynamicGraph const& g, DynamicReachability const& reach) {
+  auto const csr = g.ToCsrGraph();
+  auto const bfs = Bfs(csr, csr.Transposed(), reach.Root(), {.threads = 1});
+  int reached = 0;
+  for (int v = 0; v < g.VertexCount(); ++v) {
+    ASSERT_EQ(reach.Reached(v), bfs.distance[v] != -1) << v;
+    reached += reach.Reached(v);
+    if (!reach.Reached(v) || v == reach.Root()) {
+      ASSERT_EQ(reach.Parent(v), -1) << v;
+      continue;
+    }
+    ASSERT_TRUE(g.HasEdge(reach.Parent(v), v)) << v;
+    // a chain longer than n has a cycle
+    int steps = 0;
+    for (int u = v; u != reach.Root(); u = reach.Parent(u)) {
+      ASSERT_NE(u, -1) << v;
+      ASSERT_LE(++steps, g.VertexCount()) << v;
+    }
+  }
+  ASSERT_EQ(reach.ReachedCount(), reached);
+}
+}  // namespace
+
+TEST(DynamicReachabilityTest, PathCutAndRejoined) {
+  // 0 -> 1 -> 2 -> 3, 4 -> 2
+  DynamicGraph g{5};
+  for (auto [from, to] : {Edge{0, 1}, Edge{1, 2}, Edge{2, 3}, Edge{4, 2}}) {
+    g.AddEdge(from, to);
+  }
+  DynamicReachability reach{g, 0};
+  ASSERT_EQ(reach.ReachedCount(), 4);
+  ASSERT_EQ(reach.Parent(3), 2);
+  ASSERT_FALSE(reach.Reached(4));
+
+  std::vector<Edge> const cut{{1, 2}};
+  g.Apply({}, cut);
+  reach.Update({}, cut);
+  ASSERT_EQ(reach.ReachedCount(), 2);
+  ASSERT_EQ(reach.LastCutOff(), 2u);
+  ASSERT_FALSE(reach.Reached(3));
+
+  // reaching 4 brings 2 and 3 back through it
+  std::vector<Edge> const join{{1, 4}};
+  g.Apply(join, {});
+  reach.Update(join, {});
+  ASSERT_EQ(reach.ReachedCount(), 5);
+  ASSERT_EQ(reach.Parent(2), 4);
+  ExpectValid(g, reach);
+}
+
+TEST(DynamicReachabilityTest, CutSubtreeHangsBackOnAnotherEdge) {
+  // 0 -> 1 -> 2, 0 -> 3 -> 2: 2 hangs off 1, then off 3
+  DynamicGraph g{4};
+  for (auto [from, to] : {Edge{0, 1}, Edge{0, 3}, Edge{1, 2}, Edge{3, 2}}) {
+    g.AddEdge(from, to);
+  }
+  DynamicReachability reach{g, 0};
+  ASSERT_EQ(reach.Parent(2), 1);
+  std::vector<Edge> const cut{{1, 2}};
+  g.Apply({}, cut);
+  reach.Update({}, cut);
+  ASSERT_EQ(reach.Parent(2), 3);
+  ASSERT_EQ(reach.ReachedCount(), 4);
+}
+
+TEST(DynamicReachabilityTest, MultipleEdgeStaysTreeEdge) {
+  DynamicGraph g{2};
+  g.AddEdge(0, 1);
+  g.AddEdge(0, 1);
+  DynamicReachability reach{g, 0};
+  std::vector<Edge> const cut{{0, 1}};
+  g.Apply({}, cut);
+  reach.Update({}, cut);
+  ASSERT_EQ(reach.LastCutOff(), 0u);
+  ASSERT_EQ(reach.Parent(1), 0);
+  g.Apply({}, cut);
+  reach.Update({}, cut);
+  ASSERT_FALSE(reach.Reached(1));
+}
+
+TEST(DynamicReachabilityTest, RandomBatchesMatchRecompute) {
+  constexpr int kVertices = 300;
+  std::mt19937 gen{11};
+  std::uniform_int_distribution<int> vertex{0, kVertices - 1};
+  DynamicGraph g{kVertices};
+  std::vector<Edge> edges;
+  for (int i = 0; i < kVertices * 2; ++i) {
+    edges.push_back({vertex(gen), vertex(gen)});
+    g.AddEdge(edges.back().from, edges.back().to);
+  }
+  DynamicReachability reach{g, 0};
+  ExpectValid(g, reach);
+  for (int round = 0; round < 300; ++round) {
+    // existing edges and one random pair out, random edges in
+    std::vector<Edge> deletions;
+    for (int i = 0; i < 10 && !edges.empty(); ++i) {
+      auto const at = static_cast<std::size_t>(vertex(gen)) % edges.size();
+      deletions.push_back(edges[at]);
+      edges[at] = edges.back();
+      edges.pop_back();
+    }
+    deletions.push_back({vertex(gen), vertex(gen)});
+    std::vector<Edge> insertions(round % 2 == 0 ? 12 : 8);
+    for (auto& edge : insertions) {
+      edge = {vertex(gen), vertex(gen)};
+    }
+    g.Apply(insertions, deletions);
+    reach.Update(insertions, deletions);
+    // the miss may have hit an edge after all, so the edges come back from g
+    edges.clear();
+    auto const csr = g.ToCsrGraph();
+    for (int v = 0; v < kVertices; ++v) {
+      for (int w : csr.Neighbors(v)) {
+        edges.push_back({v, w});
+      }
+    }
+    ExpectValid(g, reach);
+  }
+}
+
+TEST(DynamicReachabilityTest, RejectsBadRoot) {
+  DynamicGraph g{2};
+  ASSERT_THROW((DynamicReachability{g, 2}), std::out_of_range);
+}
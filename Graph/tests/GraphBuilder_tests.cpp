@@ -0,0 +1,192 @@
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../GraphBuilder.hpp"
+#include "../GraphInfo.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+std::vector<Edge> RandomEdges(int vertices, std::size_t count, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<Edge> edges(count);
+  for (auto& edge : edges) {
+    edge = {vertex(gen), vertex(gen)};
+  }
+  return edges;
+}
+
+std::string ToText(std::vector<Edge> const& edges) {
+  std::string text;
+  for (auto [from, to] : edges) {
+    text += std::to_string(from) + ' ' + std::to_string(to) + '\n';
+  }
+  return text;
+}
+
+void ExpectSameGraph(CsrGraph const& a, CsrGraph const& b) {
+  ASSERT_EQ(a.VertexCount(), b.VertexCount());
+  ASSERT_TRUE(std::ranges::equal(a.Offsets(), b.Offsets()));
+  ASSERT_TRUE(std::ranges::equal(a.Targets(), b.Targets()));
+}
+
+// parses text that ends right after the number, and with 8 bytes to spare
+int Parse(std::string const& number) {
+  int value = -1;
+  for (auto const& text : {number, number + " 0000000"}) {
+    auto p = text.data();
+    if (!graph_builder_detail::ParseVertex(p, text.data() + text.size(), value)) {
+      throw std::invalid_argument(number);
+    }
+    EXPECT_EQ(p, text.data() + number.size()) << number;
+  }
+  return value;
+}
+}  // namespace
+
+TEST(GraphBuilderTest, ParsesEveryDigitCount) {
+  std::string number;
+  long long expected = 0;
+  for (int digits = 1; digits <= 10; ++digits) {
+    auto const digit = static_cast<char>('0' + digits % 10);
+    number += digit;
+    expected = expected * 10 + (digit - '0');
+    ASSERT_EQ(Parse(number), expected) << number;
+  }
+  ASSERT_EQ(Parse("0"), 0);
+  ASSERT_EQ(Parse("00000000042"), 42);
+  ASSERT_EQ(Parse("2147483647"), std::numeric_limits<int>::max());
+  ASSERT_THROW(Parse("2147483648"), std::invalid_argument);
+  ASSERT_THROW(Parse("99999999999999999999"), std::invalid_argument);
+  ASSERT_THROW(Parse(""), std::invalid_argument);
+}
+
+TEST(GraphBuilderTest, MatchesFromEdges) {
+  auto const edges = RandomEdges(1000, 20000, 1);
+  GraphBuilder builder;
+  builder.AddText(ToText(edges));
+  ExpectSameGraph(builder.Build(), CsrGraph::FromEdges(edges, 1000));
+}
+
+TEST(GraphBuilderTest, ChunksSplitAnywhere) {
+  auto const edges = RandomEdges(123456, 2000, 2);
+  auto const text = ToText(edges);
+  auto const expected = CsrGraph::FromEdges(edges, 123456);
+  for (std::size_t chunk : {1, 2, 3, 7, 8, 9, 64, 1000}) {
+    GraphBuilder builder{{.threads = 2, .vertexCount = 123456}};
+    for (std::size_t i = 0; i < text.size(); i += chunk) {
+      builder.AddText(std::string_view{text}.substr(i, chunk));
+    }
+    ExpectSameGraph(builder.Build(), expected);
+  }
+}
+
+TEST(GraphBuilderTest, ParallelSlicesKeepInputOrder) {
+  // a few hundred KB, so every thread gets a slice
+  auto const edges = RandomEdges(100000, 60000, 3);
+  auto const expected = CsrGraph::FromEdges(edges, 100000);
+  for (unsigned threads : {1u, 3u, 4u}) {
+    std::istringstream in{ToText(edges)};
+    GraphBuilder builder{{.threads = threads}};
+    builder.AddTextStream(in, 100000);
+    ASSERT_EQ(builder.EdgeCount(), edges.size());
+    ExpectSameGraph(builder.Build(), expected);
+  }
+}
+
+TEST(GraphBuilderTest, SkipsCommentsBlanksAndWeights) {
+  GraphBuilder builder;
+  builder.AddText("# comment 9 9\n% 7 7\n\n  0\t1 0.5\r\n1 2   \n2 0 3e4\n\r\n  ");
+  builder.AddText("3 0");
+  auto const g = builder.Build();
+  ASSERT_EQ(g.VertexCount(), 4);
+  ASSERT_EQ(g.EdgeCount(), 4u);
+  ASSERT_EQ(g.Neighbors(0)[0], 1);
+  ASSERT_EQ(g.Neighbors(1)[0], 2);
+  ASSERT_EQ(g.Neighbors(2)[0], 0);
+  ASSERT_EQ(g.Neighbors(3)[0], 0);
+}
+
+TEST(GraphBuilderTest, RejectsBadLines) {
+  for (auto const* text : {"0\n", "0 x\n", "-1 2\n", "1 2x\n", "1 99999999999\n"}) {
+    GraphBuilder builder;
+    ASSERT_THROW(builder.AddText(text), std::invalid_argument) << text;
+  }
+  GraphBuilder builder;
+  std::vector<Edge> const negative{{0, -1}};
+  ASSERT_THROW(builder.AddEdges(negative), std::out_of_range);
+  GraphBuilder tooSmall{{.vertexCount = 2}};
+  tooSmall.AddText("0 2\n");
+  ASSERT_THROW((void)tooSmall.Build(), std::out_of_range);
+}
+
+TEST(GraphBuilderTest, DropsSelfLoopsAndDuplicates) {
+  // the GraphWithSelfLoopAndMultipleEdges graph, plus a repeat further down
+  GraphBuilder builder{{.dropSelfLoops = true, .deduplicate = true}};
+  builder.AddText("0 0\n0 1\n0 1\n1 2\n2 1\n0 2\n0 1\n");
+  auto const g = builder.Build();
+  ASSERT_EQ(g.VertexCount(), 3);
+  ASSERT_EQ(g.EdgeCount(), 4u);
+  ASSERT_EQ(std::vector<int>(g.Neighbors(0).begin(), g.Neighbors(0).end()),
+            (std::vector<int>{1, 2}));
+  ASSERT_EQ(std::vector<int>(g.Neighbors(1).begin(), g.Neighbors(1).end()), std::vector<int>{2});
+  ASSERT_EQ(std::vector<int>(g.Neighbors(2).begin(), g.Neighbors(2).end()), std::vector<int>{1});
+
+  GraphBuilder keepAll;
+  keepAll.AddText("0 0\n0 1\n0 1\n1 2\n");
+  ASSERT_EQ(keepAll.Build().EdgeCount(), 4u);
+}
+
+TEST(GraphBuilderTest, DeduplicatesInParallel) {
+  auto edges = RandomEdges(300, 50000, 4);
+  std::vector<std::vector<int>> expected(300);
+  for (auto [from, to] : edges) {
+    if (std::ranges::find(expected[from], to) == expected[from].end()) {
+      expected[from].push_back(to);
+    }
+  }
+  GraphBuilder builder{{.threads = 4, .deduplicate = true}};
+  builder.AddEdges(edges);
+  ExpectSameGraph(builder.Build(), CsrGraph::FromAdjacency(expected));
+}
+
+TEST(GraphBuilderTest, ReadsBinaryStreams) {
+  auto const edges = RandomEdges(500, 3000, 5);
+  std::string bytes(reinterpret_cast<char const*>(edges.data()), edges.size() * sizeof(Edge));
+  std::istringstream in{bytes};
+  GraphBuilder builder{{.vertexCount = 600}};
+  builder.AddBinaryStream(in, 1000);
+  auto const g = builder.Build();
+  ASSERT_EQ(g.VertexCount(), 600);
+  ExpectSameGraph(g, CsrGraph::FromEdges(edges, 600));
+
+  std::istringstream torn{bytes.substr(0, 12)};
+  ASSERT_THROW(GraphBuilder{}.AddBinaryStream(torn), std::invalid_argument);
+}
+
+TEST(GraphBuilderTest, BuildsDfsReadyGraph) {
+  GraphBuilder builder;
+  builder.AddText("0 1\n1 2\n2 0\n");
+  auto const g = builder.Build();
+  BasicGraphInfo<CsrGraph> info;
+  info.g = g;
+  info.tIn.resize(3);
+  info.tOut.resize(3);
+  info.color.assign(3, Color::white);
+  info.parent.assign(3, -1);
+  Dfs(info, 0);
+  ASSERT_EQ(info.parent[2], 1);
+}
+
+TEST(GraphBuilderTest, EmptyInput) {
+  GraphBuilder builder;
+  builder.AddText("");
+  builder.AddText("# nothing\n");
+  auto const g = builder.Build();
+  ASSERT_EQ(g.VertexCount(), 0);
+  ASSERT_EQ(g.EdgeCount(), 0u);
+}
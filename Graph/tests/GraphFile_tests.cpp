@@ -0,0 +1,169 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../DfsWorkspace.hpp"
+#include "../GraphFile.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+// a file in the temp directory, removed again
+class TempFile {
+ public:
+  explicit TempFile(std::string const& name)
+      : m_path(std::filesystem::temp_directory_path() /
+               (name + "_" + std::to_string(std::random_device{}()))) {
+  }
+
+  ~TempFile() {
+    std::filesystem::remove(m_path);
+  }
+
+  std::filesystem::path const& Path() const {
+    return m_path;
+  }
+
+ private:
+  std::filesystem::path m_path;
+};
+
+void WriteText(std::filesystem::path const& path, std::string const& text) {
+  std::ofstream{path, std::ios::binary} << text;
+}
+
+// flips one byte at position
+void Corrupt(std::filesystem::path const& path, std::streamoff position) {
+  std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+  file.seekg(position);
+  auto const byte = static_cast<char>(file.get() ^ 0x40);
+  file.seekp(position);
+  file.put(byte);
+}
+
+CsrGraph RandomGraph(int vertices, int degree) {
+  std::mt19937 gen{9};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<Edge> edges(static_cast<std::size_t>(vertices) * degree);
+  for (auto& edge : edges) {
+    edge = {vertex(gen), vertex(gen)};
+  }
+  return CsrGraph::FromEdges(edges, vertices);
+}
+}  // namespace
+
+TEST(GraphFileTest, RoundTripsThroughTheMapping) {
+  TempFile file{"round_trip"};
+  auto const g = RandomGraph(1000, 5);
+  WriteGraphFile(file.Path(), g);
+
+  MappedGraph const mapped{file.Path(), MappedGraph::Check::full};
+  ASSERT_EQ(mapped.VertexCount(), g.VertexCount());
+  ASSERT_EQ(mapped.EdgeCount(), g.EdgeCount());
+  ASSERT_FALSE(mapped.HasWeights());
+  for (int v = 0; v < g.VertexCount(); ++v) {
+    ASSERT_TRUE(std::ranges::equal(mapped.Neighbors(v), g.Neighbors(v))) << v;
+  }
+  // the spans point into the mapping, aligned
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped.View().targets.data()) % kGraphFileAlignment, 0);
+  ASSERT_TRUE(std::ranges::equal(mapped.ToCsrGraph().Targets(), g.Targets()));
+}
+
+TEST(GraphFileTest, TraversalsRunOnTheMapping) {
+  TempFile file{"traversal"};
+  auto const g = RandomGraph(500, 3);
+  WriteGraphFile(file.Path(), g);
+  MappedGraph const mapped{file.Path()};
+
+  DfsWorkspace fromMemory{g.VertexCount()};
+  DfsWorkspace fromFile{mapped.VertexCount()};
+  auto const expected = fromMemory.VisitAll(g);
+  auto const actual = fromFile.VisitAll(mapped);
+  ASSERT_TRUE(std::ranges::equal(expected.tIn, actual.tIn));
+  ASSERT_TRUE(std::ranges::equal(expected.parent, actual.parent));
+
+  BasicGraphInfo<CsrView> info{.g = mapped.View()};
+  info.tIn.resize(500);
+  info.tOut.resize(500);
+  info.color.assign(500, Color::white);
+  info.parent.assign(500, -1);
+  Dfs(info, 0);
+  ASSERT_EQ(info.tOut[0], expected.tOut[0]);
+}
+
+TEST(GraphFileTest, ConvertsTextWithWeights) {
+  TempFile text{"weighted_txt"};
+  TempFile binary{"weighted_bin"};
+  WriteText(text.Path(),
+            "# a comment\n"
+            "2 0 0.5\n"
+            "0 1 1.5\r\n"
+            "\n"
+            "% another\n"
+            "2 1   2.5\n"
+            "0 2 3.5");
+  ConvertEdgeList(text.Path(), binary.Path());
+
+  MappedGraph const mapped{binary.Path(), MappedGraph::Check::full};
+  ASSERT_TRUE(mapped.HasWeights());
+  ASSERT_EQ(mapped.VertexCount(), 3);
+  ASSERT_TRUE(std::ranges::equal(mapped.Neighbors(0), std::vector<int>{1, 2}));
+  ASSERT_TRUE(std::ranges::equal(mapped.Neighbors(2), std::vector<int>{0, 1}));
+  ASSERT_TRUE(std::ranges::equal(mapped.View().Weights(0), std::vector<float>{1.5f, 3.5f}));
+  ASSERT_TRUE(std::ranges::equal(mapped.View().Weights(2), std::vector<float>{0.5f, 2.5f}));
+  ASSERT_TRUE(mapped.View().Weights(1).empty());
+}
+
+TEST(GraphFileTest, ParseRejectsBadLines) {
+  ASSERT_THROW(ParseEdgeList("0 x\n"), std::invalid_argument);
+  ASSERT_THROW(ParseEdgeList("0 1 2.0\n1 2\n"), std::invalid_argument);
+  ASSERT_THROW(ParseEdgeList("0 1\n1 2 3\n"), std::invalid_argument);
+  ASSERT_THROW(ParseEdgeList("-1 2\n"), std::invalid_argument);
+  ASSERT_THROW(ParseEdgeList("1 2 3 4\n"), std::invalid_argument);
+  auto const list = ParseEdgeList("");
+  ASSERT_TRUE(list.edges.empty());
+  ASSERT_EQ(list.vertexCount, 0);
+}
+
+TEST(GraphFileTest, EmptyGraph) {
+  TempFile file{"empty"};
+  WriteGraphFile(file.Path(), CsrGraph{});
+  MappedGraph const mapped{file.Path(), MappedGraph::Check::full};
+  ASSERT_EQ(mapped.VertexCount(), 0);
+  ASSERT_EQ(mapped.EdgeCount(), 0);
+}
+
+TEST(GraphFileTest, RejectsBrokenFiles) {
+  TempFile file{"broken"};
+  ASSERT_THROW(MappedGraph{file.Path()}, std::runtime_error);
+
+  WriteText(file.Path(), "0 1\n");
+  ASSERT_THROW(MappedGraph{file.Path()}, std::runtime_error);
+
+  WriteGraphFile(file.Path(), RandomGraph(100, 2));
+  Corrupt(file.Path(), 0);
+  ASSERT_THROW(MappedGraph{file.Path()}, std::runtime_error);
+
+  // a flipped target: the header is fine, only the full check sees it
+  WriteGraphFile(file.Path(), RandomGraph(100, 2));
+  auto const targetsAt = MappedGraph{file.Path()}.Header().targetsAt;
+  Corrupt(file.Path(), static_cast<std::streamoff>(targetsAt + 9));
+  ASSERT_NO_THROW(MappedGraph{file.Path()});
+  ASSERT_THROW((MappedGraph{file.Path(), MappedGraph::Check::full}), std::runtime_error);
+
+  // truncated
+  WriteGraphFile(file.Path(), RandomGraph(100, 2));
+  std::filesystem::resize_file(file.Path(), 200);
+  ASSERT_THROW(MappedGraph{file.Path()}, std::runtime_error);
+}
+
+TEST(GraphFileTest, MovesOwnership) {
+  TempFile file{"move"};
+  WriteGraphFile(file.Path(), RandomGraph(10, 2));
+  MappedGraph first{file.Path()};
+  MappedGraph second = std::move(first);
+  ASSERT_EQ(second.VertexCount(), 10);
+  first = std::move(second);
+  ASSERT_EQ(first.EdgeCount(), 20);
+}
@@ -7,7 +7,7 @@ TEST(DfsTest, SingleNodeGraph) {
   info.g.resize(1);
   info.tIn.resize(1);
   info.tOut.resize(1);
-  info.color.assign(1, "white");
+  info.color.assign(1, Color::white);
   info.parent.assign(1, -1);
 
   Dfs(info, 0);
@@ -16,7 +16,7 @@ TEST(DfsTest, SingleNodeGraph) {
   ASSERT_EQ(info.tIn[0], 0);
   ASSERT_EQ(info.tOut[0], 1);
   ASSERT_EQ(info.parent[0], -1);
-  ASSERT_EQ(info.color[0], "black");
+  ASSERT_EQ(info.color[0], Color::black);
 }
 
 TEST(DfsTest, SimplePathGraph) {
@@ -26,7 +26,7 @@ TEST(DfsTest, SimplePathGraph) {
   info.g[1].push_back(2);
   info.tIn.resize(3);
   info.tOut.resize(3);
-  info.color.assign(3, "white");
+  info.color.assign(3, Color::white);
   info.parent.assign(3, -1);
 
   Dfs(info, 0);
@@ -46,9 +46,9 @@ TEST(DfsTest, SimplePathGraph) {
   ASSERT_EQ(info.parent[2], 1);
 
   // Assert on final colors
-  ASSERT_EQ(info.color[0], "black");
-  ASSERT_EQ(info.color[1], "black");
-  ASSERT_EQ(info.color[2], "black");
+  ASSERT_EQ(info.color[0], Color::black);
+  ASSERT_EQ(info.color[1], Color::black);
+  ASSERT_EQ(info.color[2], Color::black);
 }
 
 TEST(DfsTest, BranchingGraph) {
@@ -59,7 +59,7 @@ TEST(DfsTest, BranchingGraph) {
   info.g[2].push_back(3);
   info.tIn.resize(4);
   info.tOut.resize(4);
-  info.color.assign(4, "white");
+  info.color.assign(4, Color::white);
   info.parent.assign(4, -1);
 
   Dfs(info, 0);
@@ -79,10 +79,10 @@ TEST(DfsTest, BranchingGraph) {
   ASSERT_EQ(info.parent[3], 2);
 
   // Check final colors
-  ASSERT_EQ(info.color[0], "black");
-  ASSERT_EQ(info.color[1], "black");
-  ASSERT_EQ(info.color[2], "black");
-  ASSERT_EQ(info.color[3], "black");
+  ASSERT_EQ(info.color[0], Color::black);
+  ASSERT_EQ(info.color[1], Color::black);
+  ASSERT_EQ(info.color[2], Color::black);
+  ASSERT_EQ(info.color[3], Color::black);
 }
 
 TEST(DfsTest, GraphWithCycle) {
@@ -93,12 +93,12 @@ TEST(DfsTest, GraphWithCycle) {
   info.g[2].push_back(0);  // This creates a cycle
   info.tIn.resize(3);
   info.tOut.resize(3);
-  info.color.assign(3, "white");
+  info.color.assign(3, Color::white);
   info.parent.assign(3, -1);
 
   Dfs(info, 0);
 
-  // Since the code checks for "white" color, it will not enter the cycle.
+  // Since the code only descends into white vertices, it will not enter the cycle.
   // The traversal will be 0 -> 1 -> 2. The edge 2 -> 0 will be skipped.
   ASSERT_EQ(info.tIn[0], 0);
   ASSERT_EQ(info.tIn[1], 1);
@@ -121,23 +121,23 @@ TEST(DfsTest, DisconnectedGraph) {
   info.g[2].push_back(3);  // Component 2: 2 -> 3
   info.tIn.resize(4);
   info.tOut.resize(4);
-  info.color.assign(4, "white");
+  info.color.assign(4, Color::white);
   info.parent.assign(4, -1);
 
   // Start Dfs from node 0. Only the first component will be traversed.
   Dfs(info, 0);
 
   // Assert that the first component was fully traversed.
-  ASSERT_EQ(info.color[0], "black");
-  ASSERT_EQ(info.color[1], "black");
+  ASSERT_EQ(info.color[0], Color::black);
+  ASSERT_EQ(info.color[1], Color::black);
   ASSERT_EQ(info.tIn[0], 0);
   ASSERT_EQ(info.tIn[1], 1);
   ASSERT_EQ(info.tOut[1], 2);
   ASSERT_EQ(info.tOut[0], 3);
 
   // Assert that the second component was not visited.
-  ASSERT_EQ(info.color[2], "white");
-  ASSERT_EQ(info.color[3], "white");
+  ASSERT_EQ(info.color[2], Color::white);
+  ASSERT_EQ(info.color[3], Color::white);
   ASSERT_EQ(info.parent[2], -1);
   ASSERT_EQ(info.parent[3], -1);
 }
@@ -147,7 +147,7 @@ TEST(DfsTest, LargeComplexGraph) {
   info.g.resize(1000);
   info.tIn.resize(1000);
   info.tOut.resize(1000);
-  info.color.assign(1000, "white");
+  info.color.assign(1000, Color::white);
   info.parent.assign(1000, -1);
 
   // Build a complex graph structure with branching and cycles
@@ -160,7 +160,7 @@ TEST(DfsTest, LargeComplexGraph) {
   Dfs(info, 0);
 
   // Verify that all reachable nodes were visited
-  ASSERT_EQ(info.color[999], "black");
+  ASSERT_EQ(info.color[999], Color::black);
   ASSERT_EQ(info.timer, 2000);  // 1000 nodes, each with tIn and tOut
 }
 
@@ -174,7 +174,7 @@ TEST(DfsTest, DirectedAcyclicGraph) {
   info.g[2].push_back(4);
   info.tIn.resize(5);
   info.tOut.resize(5);
-  info.color.assign(5, "white");
+  info.color.assign(5, Color::white);
   info.parent.assign(5, -1);
 
   Dfs(info, 0);
@@ -204,7 +204,7 @@ TEST(DfsTest, GraphWithSelfLoopAndMultipleEdges) {
   info.g[1].push_back(2);
   info.tIn.resize(3);
   info.tOut.resize(3);
-  info.color.assign(3, "white");
+  info.color.assign(3, Color::white);
   info.parent.assign(3, -1);
 
   Dfs(info, 0);
@@ -215,9 +215,9 @@ TEST(DfsTest, GraphWithSelfLoopAndMultipleEdges) {
   ASSERT_EQ(info.parent[0], -1);
   ASSERT_EQ(info.parent[1], 0);
   ASSERT_EQ(info.parent[2], 1);
-  ASSERT_EQ(info.color[0], "black");
-  ASSERT_EQ(info.color[1], "black");
-  ASSERT_EQ(info.color[2], "black");
+  ASSERT_EQ(info.color[0], Color::black);
+  ASSERT_EQ(info.color[1], Color::black);
+  ASSERT_EQ(info.color[2], Color::black);
 }
 
 TEST(DfsTest, DetectBackEdgeAndCycle) {
@@ -228,7 +228,7 @@ TEST(DfsTest, DetectBackEdgeAndCycle) {
   info.g[2].push_back(0);  // Back edge to a node in the current recursion stack
   info.tIn.resize(3);
   info.tOut.resize(3);
-  info.color.assign(3, "white");
+  info.color.assign(3, Color::white);
   info.parent.assign(3, -1);
 
   // Dfs must be able to handle this. Since node 0 will be "gray" when
@@ -243,7 +243,29 @@ TEST(DfsTest, DetectBackEdgeAndCycle) {
   ASSERT_EQ(info.parent[0], -1);
   ASSERT_EQ(info.parent[1], 0);
   ASSERT_EQ(info.parent[2], 1);
-  ASSERT_EQ(info.color[0], "black");
-  ASSERT_EQ(info.color[1], "black");
-  ASSERT_EQ(info.color[2], "black");
+  ASSERT_EQ(info.color[0], Color::black);
+  ASSERT_EQ(info.color[1], Color::black);
+  ASSERT_EQ(info.color[2], Color::black);
+}
+
+TEST(DfsTest, DeepPathDoesNotRecurse) {
+  constexpr int kVertices = 1 << 20;
+  GraphInfo info;
+  info.g.resize(kVertices);
+  for (int i = 0; i + 1 < kVertices; ++i) {
+    info.g[i].push_back(i + 1);
+  }
+  info.tIn.resize(kVertices);
+  info.tOut.resize(kVertices);
+  info.color.assign(kVertices, Color::white);
+  info.parent.assign(kVertices, -1);
+
+  Dfs(info, 0);
+
+  ASSERT_EQ(info.timer, 2 * kVertices);
+  ASSERT_EQ(info.tIn[kVertices - 1], kVertices - 1);
+  ASSERT_EQ(info.tOut[kVertices - 1], kVertices);
+  ASSERT_EQ(info.tOut[0], 2 * kVertices - 1);
+  ASSERT_EQ(info.parent[kVertices - 1], kVertices - 2);
+  ASSERT_TRUE(info.stack.empty());
 }
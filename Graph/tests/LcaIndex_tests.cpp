@@ -0,0 +1,148 @@
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../LcaIndex.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+// children lists of parent[], roots where parent is -1
+std::vector<std::vector<int>> Children(std::vector<int> const& parent) {
+  std::vector<std::vector<int>> g(parent.size());
+  for (std::size_t v = 0; v < parent.size(); ++v) {
+    if (parent[v] != -1) {
+      g[parent[v]].push_back(static_cast<int>(v));
+    }
+  }
+  return g;
+}
+
+// every vertex's parent has a smaller id, one in `rootEvery` is a root
+std::vector<int> RandomParents(int vertices, int rootEvery, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::vector<int> parent(vertices, -1);
+  for (int v = 1; v < vertices; ++v) {
+    if (gen() % rootEvery != 0) {
+      parent[v] = static_cast<int>(gen() % v);
+    }
+  }
+  return parent;
+}
+
+int NaiveLca(std::vector<int> const& parent, int u, int v) {
+  std::vector<bool> onPath(parent.size());
+  for (int w = u; w != -1; w = parent[w]) {
+    onPath[w] = true;
+  }
+  for (int w = v; w != -1; w = parent[w]) {
+    if (onPath[w]) {
+      return w;
+    }
+  }
+  return -1;
+}
+
+struct Tree {
+  std::vector<int> parent;
+  std::vector<std::vector<int>> g;
+  DfsWorkspace workspace;
+  LcaIndex index;
+
+  explicit Tree(std::vector<int> p)
+      : parent(std::move(p)), g(Children(parent)), workspace(VertexCount(g)) {
+    index = LcaIndex{workspace.VisitAll(g)};
+  }
+};
+}  // namespace
+
+TEST(LcaIndexTest, SmallTree) {
+  //      0
+  //    1   2
+  //   3 4   5
+  //         6
+  Tree tree{{-1, 0, 0, 1, 1, 2, 5}};
+  auto const& index = tree.index;
+  ASSERT_EQ(index.Lca(3, 4), 1);
+  ASSERT_EQ(index.Lca(3, 6), 0);
+  ASSERT_EQ(index.Lca(6, 2), 2);
+  ASSERT_EQ(index.Lca(2, 6), 2);
+  ASSERT_EQ(index.Lca(5, 5), 5);
+  ASSERT_EQ(index.Depth(6), 3);
+  ASSERT_EQ(index.SubtreeSize(1), 3);
+  ASSERT_EQ(index.SubtreeSize(0), 7);
+  ASSERT_TRUE(index.IsAncestor(0, 6));
+  ASSERT_TRUE(index.IsAncestor(2, 6));
+  ASSERT_TRUE(index.IsAncestor(6, 6));
+  ASSERT_FALSE(index.IsAncestor(1, 6));
+  ASSERT_FALSE(index.IsAncestor(6, 2));
+}
+
+TEST(LcaIndexTest, ForestHasNoCommonAncestorAcrossTrees) {
+  Tree tree{{-1, 0, -1, 2}};
+  ASSERT_EQ(tree.index.Lca(1, 3), -1);
+  ASSERT_EQ(tree.index.Lca(0, 1), 0);
+  ASSERT_FALSE(tree.index.IsAncestor(0, 3));
+}
+
+TEST(LcaIndexTest, MatchesNaiveOnRandomForests) {
+  for (int rootEvery : {1000000, 50}) {
+    Tree tree{RandomParents(5000, rootEvery, 7)};
+    std::mt19937 gen{1};
+    std::uniform_int_distribution<int> vertex{0, 4999};
+    for (int i = 0; i < 20000; ++i) {
+      auto const u = vertex(gen);
+      auto const v = vertex(gen);
+      ASSERT_EQ(tree.index.Lca(u, v), NaiveLca(tree.parent, u, v)) << u << ' ' << v;
+      ASSERT_EQ(tree.index.IsAncestor(u, v), NaiveLca(tree.parent, u, v) == u);
+    }
+  }
+}
+
+TEST(LcaIndexTest, DeepPath) {
+  constexpr int kVertices = 100000;
+  std::vector<int> parent(kVertices);
+  for (int v = 0; v < kVertices; ++v) {
+    parent[v] = v - 1;
+  }
+  Tree tree{parent};
+  ASSERT_EQ(tree.index.Lca(kVertices - 1, 12345), 12345);
+  ASSERT_EQ(tree.index.Lca(3, kVertices - 7), 3);
+  ASSERT_EQ(tree.index.Depth(kVertices - 1), kVertices - 1);
+}
+
+TEST(LcaIndexTest, BatchMatchesSingleQueries) {
+  Tree tree{RandomParents(3000, 100, 3)};
+  std::mt19937 gen{2};
+  std::uniform_int_distribution<int> vertex{0, 2999};
+  std::vector<std::pair<int, int>> queries(1000);
+  for (auto& query : queries) {
+    query = {vertex(gen), vertex(gen)};
+  }
+  std::vector<int> out(queries.size());
+  tree.index.Lca(queries, out);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    ASSERT_EQ(out[i], tree.index.Lca(queries[i].first, queries[i].second));
+  }
+  ASSERT_THROW(tree.index.Lca(queries, std::span<int>{out}.first(10)), std::invalid_argument);
+}
+
+TEST(LcaIndexTest, RequiresAFullForest) {
+  std::vector<std::vector<int>> g{{1}, {}, {}};
+  DfsWorkspace workspace{3};
+  workspace.Visit(g, 0);
+  ASSERT_THROW(LcaIndex{workspace.Forest()}, std::invalid_argument);
+}
+
+TEST(LcaIndexTest, GraphInfoAncestors) {
+  GraphInfo info;
+  info.g = {{1, 2}, {3}, {}, {}};
+  info.tIn.resize(4);
+  info.tOut.resize(4);
+  info.color.assign(4, Color::white);
+  info.parent.assign(4, -1);
+  Dfs(info, 0);
+  ASSERT_TRUE(IsAncestor(info, 0, 3));
+  ASSERT_TRUE(IsAncestor(info, 1, 3));
+  ASSERT_FALSE(IsAncestor(info, 2, 3));
+  ASSERT_FALSE(IsAncestor(info, 3, 1));
+}
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <vector>
+
+#include "../Reorder.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+CsrGraph RandomGraph(int vertices, int degree, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<Edge> edges(static_cast<std::size_t>(vertices) * degree);
+  for (auto& edge : edges) {
+    edge = {vertex(gen), vertex(gen)};
+  }
+  return CsrGraph::FromEdges(edges, vertices);
+}
+
+bool IsPermutation(Permutation const& p, int n) {
+  if (p.Size() != n) {
+    return false;
+  }
+  for (int v = 0; v < n; ++v) {
+    if (p.OldId(p.NewId(v)) != v) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// same edges, through the permutation, in the same order
+void ExpectRelabeled(CsrGraph const& g, CsrGraph const& relabeled, Permutation const& p) {
+  ASSERT_EQ(relabeled.EdgeCount(), g.EdgeCount());
+  for (int v = 0; v < g.VertexCount(); ++v) {
+    auto const expected = g.Neighbors(v);
+    auto const actual = relabeled.Neighbors(p.NewId(v));
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(actual[i], p.NewId(expected[i]));
+    }
+  }
+}
+}  // namespace
+
+TEST(ReorderTest, PermutationRoundTrips) {
+  auto const p = Permutation::FromOrder({2, 0, 3, 1});
+  ASSERT_EQ(p.NewId(2), 0);
+  ASSERT_EQ(p.OldId(0), 2);
+  std::vector<char> const values{'a', 'b', 'c', 'd'};
+  auto const moved = p.Apply<char>(values);
+  ASSERT_EQ(moved, (std::vector<char>{'c', 'a', 'd', 'b'}));
+  ASSERT_EQ(p.Restore<char>(moved), values);
+
+  std::vector<int> const parent{-1, 0, 0, 2};
+  auto const newParent = p.ApplyIds(parent);
+  // old 3 is new 2, its parent old 2 is new 0; old 0 is new 1
+  ASSERT_EQ(newParent[2], 0);
+  ASSERT_EQ(newParent[1], -1);
+  ASSERT_EQ(p.RestoreIds(newParent), parent);
+}
+
+TEST(ReorderTest, RejectsNonPermutations) {
+  ASSERT_THROW(Permutation::FromOrder({0, 0}), std::invalid_argument);
+  ASSERT_THROW(Permutation::FromOrder({0, 2}), std::invalid_argument);
+  auto const g = CsrGraph::FromAdjacency({{1}, {}});
+  ASSERT_THROW(Relabel(g, Permutation::Identity(3)), std::invalid_argument);
+}
+
+TEST(ReorderTest, EveryStrategyIsAPermutationAndRelabelsEdges) {
+  auto const g = RandomGraph(3000, 4, 5);
+  DfsWorkspace workspace{g.VertexCount()};
+  for (auto const& p : {DfsOrder(workspace.VisitAll(g)), DfsOrder(g), DegreeOrder(g),
+                        ReverseCuthillMcKee(g), CommunityOrder(g)}) {
+    ASSERT_TRUE(IsPermutation(p, g.VertexCount()));
+    ExpectRelabeled(g, Relabel(g, p), p);
+  }
+}
+
+TEST(ReorderTest, DfsOrderNumbersInPreorder) {
+  auto const g = CsrGraph::FromAdjacency({{2}, {}, {1}});
+  auto const p = DfsOrder(g);
+  ASSERT_EQ(p.NewId(0), 0);
+  ASSERT_EQ(p.NewId(2), 1);
+  ASSERT_EQ(p.NewId(1), 2);
+  // preorder relabeling makes the Dfs timestamps increase with the id
+  DfsWorkspace workspace{3};
+  auto const forest = workspace.VisitAll(Relabel(g, p));
+  ASSERT_LT(forest.tIn[0], forest.tIn[1]);
+  ASSERT_LT(forest.tIn[1], forest.tIn[2]);
+}
+
+TEST(ReorderTest, DegreeOrderPutsHubsFirst) {
+  auto const g = CsrGraph::FromAdjacency({{}, {0, 2}, {0}, {0, 1, 2}});
+  auto const p = DegreeOrder(g);
+  ASSERT_EQ(std::vector<int>(p.OldIds().begin(), p.OldIds().end()), (std::vector<int>{3, 1, 2, 0}));
+}
+
+TEST(ReorderTest, RcmNarrowsThePathBand) {
+  // a path with shuffled ids, stored both ways
+  constexpr int kVertices = 1000;
+  std::vector<int> ids(kVertices);
+  std::iota(ids.begin(), ids.end(), 0);
+  std::ranges::shuffle(ids, std::mt19937{3});
+  std::vector<Edge> edges;
+  for (int i = 0; i + 1 < kVertices; ++i) {
+    edges.push_back({ids[i], ids[i + 1]});
+    edges.push_back({ids[i + 1], ids[i]});
+  }
+  auto const shuffled = CsrGraph::FromEdges(edges, kVertices);
+  auto const g = Relabel(shuffled, ReverseCuthillMcKee(shuffled));
+  for (int v = 0; v < kVertices; ++v) {
+    for (int w : g.Neighbors(v)) {
+      ASSERT_EQ(std::abs(v - w), 1);
+    }
+  }
+}
+
+TEST(ReorderTest, CommunityOrderKeepsCliquesContiguous) {
+  // 10 cliques of 8 with shuffled ids and a ring of single links
+  constexpr int kCliques = 10;
+  constexpr int kSize = 8;
+  std::vector<int> ids(kCliques * kSize);
+  std::iota(ids.begin(), ids.end(), 0);
+  std::ranges::shuffle(ids, std::mt19937{4});
+  std::vector<Edge> edges;
+  for (int c = 0; c < kCliques; ++c) {
+    for (int a = 0; a < kSize; ++a) {
+      for (int b = 0; b < kSize; ++b) {
+        if (a != b) {
+          edges.push_back({ids[c * kSize + a], ids[c * kSize + b]});
+        }
+      }
+    }
+    edges.push_back({ids[c * kSize], ids[(c + 1) % kCliques * kSize]});
+  }
+  auto const g = CsrGraph::FromEdges(edges, kCliques * kSize);
+  auto const p = CommunityOrder(g);
+  for (int c = 0; c < kCliques; ++c) {
+    auto const newIds = std::views::iota(0, kSize) |
+                        std::views::transform([&](int a) { return p.NewId(ids[c * kSize + a]); });
+    auto const [low, high] = std::ranges::minmax(newIds);
+    ASSERT_EQ(high - low, kSize - 1) << c;
+  }
+}
+
+TEST(ReorderTest, RelabelsGraphInfo) {
+  GraphInfo info;
+  info.g = {{1, 2}, {}, {1}};
+  info.tIn.resize(3);
+  info.tOut.resize(3);
+  info.color.assign(3, Color::white);
+  info.parent.assign(3, -1);
+  Dfs(info, 0);
+
+  auto const p = Permutation::FromOrder({1, 2, 0});
+  auto const relabeled = Relabel(info, p);
+  // old 0 is new 2
+  ASSERT_EQ(relabeled.g[2], (std::vector<int>{0, 1}));
+  ASSERT_EQ(relabeled.tIn[2], 0);
+  ASSERT_EQ(relabeled.parent[0], 2);
+  ASSERT_EQ(p.RestoreIds(relabeled.parent), info.parent);
+  ASSERT_EQ(p.Restore<int>(relabeled.tOut), info.tOut);
+}
@@ -0,0 +1,136 @@
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../Scc.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+// same partition, whatever the ids
+bool SamePartition(std::vector<int> const& a, std::vector<int> const& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  std::map<int, int> forward;
+  std::map<int, int> backward;
+  for (std::size_t v = 0; v < a.size(); ++v) {
+    if (forward.try_emplace(a[v], b[v]).first->second != b[v] ||
+        backward.try_emplace(b[v], a[v]).first->second != a[v]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CsrGraph RandomGraph(int vertices, int edgesPerVertex, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::vector<Edge> edges(static_cast<std::size_t>(vertices) * edgesPerVertex);
+  for (auto& edge : edges) {
+    edge = {vertex(gen), vertex(gen)};
+  }
+  return CsrGraph::FromEdges(edges, vertices);
+}
+
+void ExpectTopological(CsrGraph const& g, SccInfo const& scc) {
+  for (int u = 0; u < g.VertexCount(); ++u) {
+    for (int v : g.Neighbors(u)) {
+      ASSERT_LE(scc.component[u], scc.component[v]) << u << " -> " << v;
+    }
+  }
+}
+
+void ExpectParallelMatchesTarjan(CsrGraph const& g) {
+  auto const tarjan = TarjanScc(g);
+  ExpectTopological(g, tarjan);
+  auto const reverse = g.Transposed();
+  for (unsigned threads : {1u, 4u}) {
+    auto const parallel = ParallelScc(g, reverse, threads);
+    ASSERT_EQ(parallel.count, tarjan.count);
+    ASSERT_TRUE(SamePartition(parallel.component, tarjan.component)) << threads;
+  }
+}
+}  // namespace
+
+TEST(SccTest, TwoCyclesAndATail) {
+  // {0, 1, 2} -> {3, 4} -> 5
+  auto const g = CsrGraph::FromAdjacency({{1}, {2}, {0, 3}, {4}, {3, 5}, {}});
+  auto const scc = TarjanScc(g);
+  ASSERT_EQ(scc.count, 3);
+  ASSERT_EQ(scc.component, (std::vector<int>{0, 0, 0, 1, 1, 2}));
+  ExpectParallelMatchesTarjan(g);
+}
+
+TEST(SccTest, WorksOnAdjacencyLists) {
+  std::vector<std::vector<int>> g{{1}, {0}, {1}};
+  auto const scc = TarjanScc(g);
+  ASSERT_EQ(scc.count, 2);
+  ASSERT_EQ(scc.component, (std::vector<int>{1, 1, 0}));
+}
+
+TEST(SccTest, LongPathIsAllSingletons) {
+  constexpr int kVertices = 1 << 18;
+  std::vector<Edge> edges;
+  for (int v = 0; v + 1 < kVertices; ++v) {
+    edges.push_back({v, v + 1});
+  }
+  auto const g = CsrGraph::FromEdges(edges, kVertices);
+  auto const scc = TarjanScc(g);
+  ASSERT_EQ(scc.count, kVertices);
+  ASSERT_EQ(scc.component[kVertices - 1], kVertices - 1);
+  ASSERT_FALSE(HasCycle(g, scc));
+  ExpectParallelMatchesTarjan(g);
+}
+
+TEST(SccTest, LongCycleIsOneComponent) {
+  constexpr int kVertices = 1 << 18;
+  std::vector<Edge> edges;
+  for (int v = 0; v < kVertices; ++v) {
+    edges.push_back({v, (v + 1) % kVertices});
+  }
+  auto const g = CsrGraph::FromEdges(edges, kVertices);
+  auto const scc = TarjanScc(g);
+  ASSERT_EQ(scc.count, 1);
+  ASSERT_TRUE(HasCycle(g, scc));
+  ExpectParallelMatchesTarjan(g);
+}
+
+TEST(SccTest, SelfLoopIsACycle) {
+  auto const g = CsrGraph::FromAdjacency({{1}, {1}});
+  auto const scc = TarjanScc(g);
+  ASSERT_EQ(scc.count, 2);
+  ASSERT_TRUE(HasCycle(g, scc));
+  ExpectParallelMatchesTarjan(g);
+}
+
+TEST(SccTest, RandomGraphsMatchTarjan) {
+  // below, around and above the point where a giant component appears
+  for (int edgesPerVertex : {1, 2, 4}) {
+    for (unsigned seed : {1u, 2u, 3u}) {
+      ExpectParallelMatchesTarjan(RandomGraph(20000, edgesPerVertex, seed));
+    }
+  }
+}
+
+TEST(SccTest, ChainOfSmallCycles) {
+  // 1000 triangles, each with an edge into the next
+  constexpr int kTriangles = 1000;
+  std::vector<Edge> edges;
+  for (int t = 0; t < kTriangles; ++t) {
+    auto const v = 3 * t;
+    edges.push_back({v, v + 1});
+    edges.push_back({v + 1, v + 2});
+    edges.push_back({v + 2, v});
+    if (t + 1 < kTriangles) {
+      edges.push_back({v + 2, v + 3});
+    }
+  }
+  auto const g = CsrGraph::FromEdges(edges, 3 * kTriangles);
+  ASSERT_EQ(TarjanScc(g).count, kTriangles);
+  ExpectParallelMatchesTarjan(g);
+}
+
+TEST(SccTest, RejectsWrongTranspose) {
+  auto const g = CsrGraph::FromAdjacency({{1}, {}});
+  ASSERT_THROW(ParallelScc(g, CsrGraph::FromAdjacency({{}, {}})), std::invalid_argument);
+}
@@ -1,7 +1,22 @@
 #pragma once
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 
+// std::hardware_destructive_interference_size is not ABI-stable (gcc warns)
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// a pool slot holds either a live T or a free list link
+template <typename T>
+inline constexpr std::size_t kSlotAlignment =
+    alignof(T) > alignof(std::uintptr_t) ? alignof(T) : alignof(std::uintptr_t);
+
+template <typename T>
+inline constexpr std::size_t kSlotSize =
+    ((sizeof(T) > sizeof(std::uintptr_t) ? sizeof(T) : sizeof(std::uintptr_t)) +
+     kSlotAlignment<T> - 1) &
+    ~(kSlotAlignment<T> - 1);
+
 /// powered by https://github.com/google/filament/blob/main/libs/utils/include/utils/Allocator.h
 template<typename Ptr>
 static Ptr* AddPtr(Ptr* ptr, std::size_t b) noexcept {
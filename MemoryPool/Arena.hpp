@@ -0,0 +1,281 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AlignUtils.hpp"
+#include "MemoryPool.hpp"
+#include "PoolStorage.hpp"
+
+// Monotonic arena: bump-pointer allocation of any type, nothing is freed
+// one by one. Rewind(Mark()) or Reset() drops everything allocated since,
+// in O(1) plus one call per registered destructor. Exhausted blocks chain
+// a new one as GrowthPolicy says (in bytes here), GrowthPolicy::Fixed()
+// keeps the arena inside its first block. Blocks survive Reset and are
+// reused, Release() hands the grown ones back.
+// Single threaded.
+template <typename Storage = HeapStorage>
+class Arena {
+  static constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+  struct Block {
+    std::span<std::byte> memory;
+    // false for the caller's buffer
+    bool owned;
+  };
+
+  // lives in the arena in front of the object it destroys
+  struct Finalizer {
+    void (*destroy)(void*) noexcept;
+    void* object;
+    Finalizer* next;
+  };
+
+ public:
+  static constexpr std::size_t kDefaultBlockBytes = std::size_t{64} << 10;
+
+  // where Rewind goes back to
+  struct Marker {
+    std::size_t block;
+    std::byte* cursor;
+    Finalizer* finalizers;
+  };
+
+  explicit Arena(std::size_t blockBytes = kDefaultBlockBytes, GrowthPolicy growth = {},
+                 Storage storage = {})
+      : m_storage(std::move(storage)), m_growth(growth) {
+    // the push_back below can't throw and leak the block
+    m_blocks.reserve(1);
+    m_blocks.push_back({m_storage.Allocate(blockBytes, kBlockAlignment), true});
+    Enter(0);
+  }
+
+  // starts in buffer, e.g. on the stack, which must outlive the arena
+  explicit Arena(std::span<std::byte> buffer, GrowthPolicy growth = GrowthPolicy::Fixed(),
+                 Storage storage = {})
+      : m_storage(std::move(storage)), m_growth(growth), m_blocks{{buffer, false}} {
+    Enter(0);
+  }
+
+  ~Arena() noexcept {
+    Finalize(nullptr);
+    for (auto const& block : m_blocks) {
+      if (block.owned) {
+        m_storage.Deallocate(block.memory, kBlockAlignment);
+      }
+    }
+  }
+
+  // Non-copyable
+  Arena(Arena const& other) = delete;
+
+  Arena& operator=(Arena const& other) = delete;
+
+  // Non-movable
+  // containers keep pointers to the arena
+  Arena(Arena&& other) noexcept = delete;
+
+  Arena& operator=(Arena&& other) noexcept = delete;
+
+ public:
+  // nullptr when the arena may not grow anymore
+  [[nodiscard]] void* Allocate(std::size_t bytes, std::size_t alignment) noexcept {
+    auto const cursor = reinterpret_cast<std::uintptr_t>(Align(m_cursor, alignment));
+    if (cursor <= m_end && m_end - cursor >= bytes) {
+      m_cursor = reinterpret_cast<std::byte*>(cursor + bytes);
+      return reinterpret_cast<void*>(cursor);
+    }
+    return AllocateSlow(bytes, alignment);
+  }
+
+  // uninitialized storage for count Ts
+  template <typename T>
+  [[nodiscard]] T* AllocateArray(std::size_t count) noexcept {
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      return nullptr;
+    }
+    return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  // non-trivial destructors run on Rewind/Reset, nullptr when exhausted
+  template <typename T, typename... U>
+  [[nodiscard]] T* Create(U&&... args) noexcept(std::is_nothrow_constructible_v<T, U...>) {
+    if constexpr (std::is_trivially_destructible_v<T>) {
+      auto const memory = Allocate(sizeof(T), alignof(T));
+      return memory == nullptr ? nullptr : new (memory) T(std::forward<U>(args)...);
+    } else {
+      auto const finalizer = static_cast<Finalizer*>(Allocate(sizeof(Finalizer), alignof(Finalizer)));
+      auto const memory = finalizer == nullptr ? nullptr : Allocate(sizeof(T), alignof(T));
+      if (memory == nullptr) {
+        return nullptr;
+      }
+      // a throwing ctor leaves both unlinked, they go with the next Rewind
+      auto const object = new (memory) T(std::forward<U>(args)...);
+      m_finalizers = new (finalizer) Finalizer{
+          [](void* ptr) noexcept { static_cast<T*>(ptr)->~T(); }, object, m_finalizers};
+      return object;
+    }
+  }
+
+  [[nodiscard]] Marker Mark() const noexcept {
+    return {m_current, m_cursor, m_finalizers};
+  }
+
+  // destroys what was Created after marker, newest first
+  void Rewind(Marker const& marker) noexcept {
+    Finalize(marker.finalizers);
+    Enter(marker.block);
+    m_cursor = marker.cursor;
+  }
+
+  void Reset() noexcept {
+    Finalize(nullptr);
+    Enter(0);
+  }
+
+  // Reset and give grown blocks back to Storage
+  void Release() noexcept {
+    Reset();
+    while (m_blocks.size() > 1) {
+      if (m_blocks.back().owned) {
+        m_storage.Deallocate(m_blocks.back().memory, kBlockAlignment);
+      }
+      m_blocks.pop_back();
+    }
+  }
+
+  // bytes handed out, alignment padding and skipped block tails included
+  [[nodiscard]] std::size_t Used() const noexcept {
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < m_current; ++i) {
+      used += m_blocks[i].memory.size();
+    }
+    return used + static_cast<std::size_t>(m_cursor - m_blocks[m_current].memory.data());
+  }
+
+  [[nodiscard]] std::size_t Capacity() const noexcept {
+    std::size_t capacity = 0;
+    for (auto const& block : m_blocks) {
+      capacity += block.memory.size();
+    }
+    return capacity;
+  }
+
+  [[nodiscard]] std::size_t BlockCount() const noexcept {
+    return m_blocks.size();
+  }
+
+  [[nodiscard]] Storage& GetStorage() noexcept {
+    return m_storage;
+  }
+
+ private:
+  void Enter(std::size_t block) noexcept {
+    m_current = block;
+    m_cursor = m_blocks[block].memory.data();
+    m_end = reinterpret_cast<std::uintptr_t>(m_cursor + m_blocks[block].memory.size());
+  }
+
+  // the rest of the current block is skipped, a later Rewind gets it back
+  [[nodiscard]] void* AllocateSlow(std::size_t bytes, std::size_t alignment) noexcept {
+    // worst case padding at the block start
+    auto const needed = bytes + (alignment > kBlockAlignment ? alignment : 0);
+    if (needed < bytes) {
+      return nullptr;
+    }
+
+    // blocks kept by Reset first
+    while (m_current + 1 < m_blocks.size()) {
+      Enter(m_current + 1);
+      auto const cursor = reinterpret_cast<std::uintptr_t>(Align(m_cursor, alignment));
+      if (cursor <= m_end && m_end - cursor >= bytes) {
+        m_cursor = reinterpret_cast<std::byte*>(cursor + bytes);
+        return reinterpret_cast<void*>(cursor);
+      }
+    }
+
+    auto const capacity = Capacity();
+    auto size = m_growth.NextSlabSize(capacity);
+    if (size == 0) {
+      return nullptr;
+    }
+    if (size < needed) {
+      if (needed > m_growth.maxCapacity - capacity) {
+        return nullptr;
+      }
+      size = needed;
+    }
+
+    try {
+      m_blocks.reserve(m_blocks.size() + 1);
+      m_blocks.push_back({m_storage.Allocate(size, kBlockAlignment), true});
+    } catch (std::bad_alloc const&) {
+      return nullptr;
+    }
+    Enter(m_blocks.size() - 1);
+    auto const cursor = Align(m_cursor, alignment);
+    m_cursor = cursor + bytes;
+    return cursor;
+  }
+
+  void Finalize(Finalizer* until) noexcept {
+    while (m_finalizers != until) {
+      m_finalizers->destroy(m_finalizers->object);
+      m_finalizers = m_finalizers->next;
+    }
+  }
+
+ private:
+  [[no_unique_address]] Storage m_storage;
+  GrowthPolicy m_growth;
+  std::vector<Block> m_blocks;
+  std::size_t m_current = 0;
+  std::byte* m_cursor = nullptr;
+  std::uintptr_t m_end = 0;
+  Finalizer* m_finalizers = nullptr;
+};
+
+// std::pmr face of Arena, for request-scoped pmr containers.
+// deallocate is a no-op, memory comes back with GetArena().Reset().
+template <typename Storage = HeapStorage>
+class ArenaResource : public std::pmr::memory_resource {
+ public:
+  explicit ArenaResource(std::size_t blockBytes = Arena<Storage>::kDefaultBlockBytes,
+                         GrowthPolicy growth = {})
+      : m_arena(blockBytes, growth) {
+  }
+
+  explicit ArenaResource(std::span<std::byte> buffer,
+                         GrowthPolicy growth = GrowthPolicy::Fixed())
+      : m_arena(buffer, growth) {
+  }
+
+  [[nodiscard]] Arena<Storage>& GetArena() noexcept {
+    return m_arena;
+  }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (auto ptr = m_arena.Allocate(bytes, alignment)) {
+      return ptr;
+    }
+    throw std::bad_alloc{};
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {
+  }
+
+  [[nodiscard]] bool do_is_equal(
+      std::pmr::memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  Arena<Storage> m_arena;
+};
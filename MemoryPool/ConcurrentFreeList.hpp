@@ -0,0 +1,338 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "SlotLayout.hpp"
+
+namespace detail {
+// Dense ids for live threads, recycled on thread exit.
+// Lock-free and allocation-free: it has to be usable from operator new.
+class ThreadIndex {
+  static constexpr std::size_t kWordBits = 64;
+  static constexpr std::size_t kWords = 2;
+
+ public:
+  static constexpr std::size_t kMaxThreads = kWordBits * kWords;
+  static constexpr std::size_t kNone = kMaxThreads;
+
+  // kNone when every id is taken
+  [[nodiscard]] static std::size_t Get() noexcept {
+    thread_local Holder holder;
+    return holder.index;
+  }
+
+ private:
+  struct Holder {
+    std::size_t index = Acquire();
+
+    Holder() = default;
+    Holder(Holder const&) = delete;
+    Holder& operator=(Holder const&) = delete;
+
+    ~Holder() {
+      Release(index);
+    }
+  };
+
+  static std::size_t Acquire() noexcept {
+    for (std::size_t w = 0; w < kWords; ++w) {
+      auto used = s_used[w].load(std::memory_order_relaxed);
+      while (~used != 0) {
+        auto const bit = static_cast<std::size_t>(std::countr_one(used));
+        if (s_used[w].compare_exchange_weak(used, used | (1ull << bit),
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+          return w * kWordBits + bit;
+        }
+      }
+    }
+    return kNone;
+  }
+
+  static void Release(std::size_t index) noexcept {
+    if (index == kNone) {
+      return;
+    }
+    // release: the next owner of the id sees our magazines
+    s_used[index / kWordBits].fetch_and(~(1ull << (index % kWordBits)),
+                                        std::memory_order_release);
+  }
+
+  inline static constinit std::array<std::atomic<std::uint64_t>, kWords>
+      s_used{};
+};
+}  // namespace detail
+
+// Treiber stack of intrusive nodes. The head is a tagged pointer (ABA-safe):
+// every head change bumps the tag, so a stale CAS always fails.
+// Popped nodes are handed out, but their memory must outlive the stack.
+class LockFreeStack {
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+  // 48-bit pointer + 16-bit tag on 64-bit targets, 32 + 32 otherwise
+  static constexpr unsigned kPtrBits = sizeof(void*) == 8 ? 48 : 32;
+  static constexpr std::uint64_t kPtrMask = (1ull << kPtrBits) - 1;
+
+ public:
+  struct Node {
+    std::atomic<Node*> next = nullptr;
+  };
+
+  LockFreeStack() = default;
+
+  LockFreeStack(LockFreeStack const& other) = delete;
+  LockFreeStack& operator=(LockFreeStack const& other) = delete;
+
+  // links first..last (already chained through next) on top
+  void PushChain(Node* first, Node* last) noexcept {
+    auto head = m_head.load(std::memory_order_relaxed);
+    do {
+      last->next.store(Ptr(head), std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(head, Pack(first, NextTag(head)),
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+  }
+
+  // unlinks up to count nodes with a single CAS
+  std::size_t PopChain(Node** out, std::size_t count) noexcept {
+    auto head = m_head.load(std::memory_order_acquire);
+    for (;;) {
+      std::size_t n = 0;
+      auto cur = Ptr(head);
+      bool stale = false;
+      // nodes may be handed out concurrently, their memory stays ours though.
+      // An unchanged tagged head proves the walked prefix is still linked.
+      while (cur != nullptr && n < count) {
+        auto next = cur->next.load(std::memory_order_relaxed);
+        if (m_head.load(std::memory_order_acquire) != head) {
+          stale = true;
+          break;
+        }
+        out[n++] = cur;
+        cur = next;
+      }
+
+      if (stale) {
+        head = m_head.load(std::memory_order_acquire);
+        continue;
+      }
+      if (n == 0) {
+        return 0;
+      }
+      if (m_head.compare_exchange_weak(head, Pack(cur, NextTag(head)),
+                                       std::memory_order_acquire,
+                                       std::memory_order_acquire)) {
+        return n;
+      }
+    }
+  }
+
+  // chains nodes[0..count) through next
+  static void Link(Node* const* nodes, std::size_t count) noexcept {
+    for (std::size_t i = 1; i < count; ++i) {
+      nodes[i - 1]->next.store(nodes[i], std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  static std::uint64_t Pack(Node* node, std::uint64_t tag) noexcept {
+    auto const bits = reinterpret_cast<std::uintptr_t>(node);
+    assert((bits & ~kPtrMask) == 0 && "Pointer does not fit tagged head");
+    return static_cast<std::uint64_t>(bits) | (tag << kPtrBits);
+  }
+
+  static Node* Ptr(std::uint64_t head) noexcept {
+    return reinterpret_cast<Node*>(static_cast<std::uintptr_t>(head & kPtrMask));
+  }
+
+  static std::uint64_t NextTag(std::uint64_t head) noexcept {
+    return (head >> kPtrBits) + 1;
+  }
+
+ private:
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> m_head{0};
+};
+
+// Lock-free LIFO with per-thread magazines.
+// Global list is a LockFreeStack. Each thread keeps a bounded magazine of
+// slots, it is refilled from and drained to the global list kBatch slots
+// per CAS.
+// At most kMagazineSize slots per thread may be stranded, see Flush.
+template <typename T, typename SlotLayout = PackedLayout>
+class ConcurrentFreeList {
+public:
+  using Layout = SlotLayout;
+  static constexpr std::size_t kMagazineSize = 64;
+  static constexpr std::size_t kBatch = kMagazineSize / 2;
+
+  using Node = LockFreeStack::Node;
+
+private:
+  struct alignas(kCacheLineSize) Magazine {
+    std::size_t count = 0;
+    std::array<Node*, kMagazineSize> slots;
+  };
+
+public:
+  ConcurrentFreeList() = delete;
+
+  explicit ConcurrentFreeList(std::byte* begin, std::size_t space)
+      : m_magazines(std::make_unique<Magazine[]>(
+            detail::ThreadIndex::kMaxThreads)) {
+    Extend(begin, space);
+  }
+
+  ~ConcurrentFreeList() = default;
+
+  ConcurrentFreeList(ConcurrentFreeList const& other) = delete;
+  ConcurrentFreeList& operator=(ConcurrentFreeList const& other) = delete;
+  ConcurrentFreeList(ConcurrentFreeList&& other) noexcept = delete;
+  ConcurrentFreeList& operator=(ConcurrentFreeList&& other) noexcept = delete;
+
+public:
+  T * Pop() noexcept {
+    auto magazine = LocalMagazine();
+    if (magazine == nullptr) {
+      Node* node = nullptr;
+      m_stack.PopChain(&node, 1);
+      return reinterpret_cast<T *>(node);
+    }
+
+    if (magazine->count == 0) {
+      magazine->count = m_stack.PopChain(magazine->slots.data(), kBatch);
+      if (magazine->count == 0) {
+        return nullptr;
+      }
+    }
+    // let the user beware of lifetime
+    return reinterpret_cast<T *>(magazine->slots[--magazine->count]);
+  }
+
+  void Push(T * ptr) noexcept {
+    // begins lifetime of Node
+    auto node = new (ptr) Node;
+    auto magazine = LocalMagazine();
+    if (magazine == nullptr) {
+      m_stack.PushChain(node, node);
+      return;
+    }
+
+    if (magazine->count == kMagazineSize) {
+      // the oldest slots go back, the hot ones stay
+      Drain(*magazine, kBatch);
+    }
+    magazine->slots[magazine->count++] = node;
+  }
+
+  // magazine first, then the global list kBatch slots per CAS
+  std::size_t PopBatch(T ** out, std::size_t count) noexcept {
+    std::size_t n = 0;
+    if (auto magazine = LocalMagazine()) {
+      auto const cached = std::min(count, magazine->count);
+      for (; n < cached; ++n) {
+        // let the user beware of lifetime
+        out[n] = reinterpret_cast<T *>(magazine->slots[--magazine->count]);
+      }
+    }
+
+    std::array<Node*, kBatch> chain;
+    while (n < count) {
+      auto const popped = m_stack.PopChain(chain.data(), std::min(count - n, kBatch));
+      if (popped == 0) {
+        break;
+      }
+      for (std::size_t i = 0; i < popped; ++i) {
+        out[n++] = reinterpret_cast<T *>(chain[i]);
+      }
+    }
+    return n;
+  }
+
+  // magazine first, the overflow goes to the global list with a single CAS
+  void PushBatch(T * const* ptrs, std::size_t count) noexcept {
+    std::size_t n = 0;
+    if (auto magazine = LocalMagazine()) {
+      auto const cached = std::min(count, kMagazineSize - magazine->count);
+      for (; n < cached; ++n) {
+        // begins lifetime of Node
+        magazine->slots[magazine->count++] = new (ptrs[n]) Node;
+      }
+    }
+    if (n == count) {
+      return;
+    }
+
+    // same order as Pushing ptrs one by one
+    // begins lifetime of Node
+    Node* last = new (ptrs[n]) Node;
+    Node* first = last;
+    for (++n; n < count; ++n) {
+      // begins lifetime of Node
+      auto node = new (ptrs[n]) Node;
+      node->next.store(first, std::memory_order_relaxed);
+      first = node;
+    }
+    m_stack.PushChain(first, last);
+  }
+
+  // threads another block of space slots on top of the global list
+  void Extend(std::byte* begin, std::size_t space) noexcept {
+    auto [first, last] = Thread(begin, space);
+    if (first != nullptr) {
+      m_stack.PushChain(first, last);
+    }
+  }
+
+  // returns calling thread's cached slots to the global list
+  void Flush() noexcept {
+    if (auto magazine = LocalMagazine()) {
+      Drain(*magazine, magazine->count);
+    }
+  }
+
+private:
+  static std::pair<Node*, Node*> Thread(std::byte* begin, std::size_t space) noexcept {
+    if (space == 0) {
+      return {nullptr, nullptr};
+    }
+    // same order as FreeList: the last slot ends up on top
+    SlotSequence<T, SlotLayout> fresh(begin, space);
+    // begins lifetime of Node
+    Node* last = new (fresh.Next()) Node;
+    Node* first = last;
+    while (auto slot = fresh.Next()) {
+      // begins lifetime of Node
+      auto node = new (slot) Node;
+      node->next.store(first, std::memory_order_relaxed);
+      first = node;
+    }
+    return {first, last};
+  }
+
+  Magazine* LocalMagazine() const noexcept {
+    auto const index = detail::ThreadIndex::Get();
+    return index == detail::ThreadIndex::kNone ? nullptr : &m_magazines[index];
+  }
+
+  void Drain(Magazine& magazine, std::size_t count) noexcept {
+    if (count == 0) {
+      return;
+    }
+    auto const slots = magazine.slots.data();
+    LockFreeStack::Link(slots, count);
+    m_stack.PushChain(slots[0], slots[count - 1]);
+    std::copy(slots + count, slots + magazine.count, slots);
+    magazine.count -= count;
+  }
+
+private:
+  LockFreeStack m_stack;
+  std::unique_ptr<Magazine[]> m_magazines;
+};
@@ -1,28 +1,33 @@
 ﻿#pragma once
-#include "AlignUtils.hpp"
+#include <concepts>
+#include <memory>
+
+#include "SlotLayout.hpp"
+
+// free lists a growable MemoryPool can give slabs back from
+template <typename List, typename T>
+concept TrimmableFreeList = requires(List& list, bool (*pred)(T const*)) {
+  list.ForEach(pred);
+  list.RemoveIf(pred);
+};
+
+// free lists that unlink and splice whole chains
+template <typename List, typename T>
+concept BatchFreeList = requires(List& list, T** out, T* const* ptrs, std::size_t count) {
+  { list.PopBatch(out, count) } -> std::same_as<std::size_t>;
+  list.PushBatch(ptrs, count);
+};
 
 // LIFO
-template <typename T>
-requires (alignof(T) >= alignof(uintptr_t))
+template <typename T, typename SlotLayout = PackedLayout>
 class FreeList {
-  inline static constinit auto kAlignment = alignof(T);
-  inline static constinit auto kSize = sizeof(T);
-
 public:
+  using Layout = SlotLayout;
+
   FreeList() = delete;
 
   explicit FreeList(std::byte* begin, std::size_t space) noexcept {
-    auto beg = Align(begin, kAlignment);
-    // begins lifetime of Node
-    m_head = new (beg) Node;
-    auto cur = m_head;
-    for (std::size_t i = 1; i < space; ++i) {
-      // begins lifetime of Node
-      m_head = std::construct_at(Align(AddPtr(cur, kSize), kAlignment));
-      // well-defined
-      m_head->next = cur;
-      cur = m_head;
-    }
+    Extend(begin, space);
   }
 
   ~FreeList() = default;
@@ -48,6 +53,64 @@ public:
     m_head = head;
   }
 
+  // same as up to count Pops, one head write
+  std::size_t PopBatch(T ** out, std::size_t count) noexcept {
+    std::size_t n = 0;
+    auto head = m_head;
+    for (; n < count && head != nullptr; ++n) {
+      // let the user beware of lifetime
+      out[n] = reinterpret_cast<T *>(head);
+      head = head->next;
+    }
+    m_head = head;
+    return n;
+  }
+
+  // same as Pushing ptrs in order, one head write
+  void PushBatch(T * const* ptrs, std::size_t count) noexcept {
+    auto head = m_head;
+    for (std::size_t i = 0; i < count; ++i) {
+      // begins lifetime of Node
+      auto node = new (ptrs[i]) Node;
+      // well-defined
+      node->next = head;
+      head = node;
+    }
+    m_head = head;
+  }
+
+  // threads another block of space slots on top of the list
+  void Extend(std::byte* begin, std::size_t space) noexcept {
+    SlotSequence<T, SlotLayout> fresh(begin, space);
+    while (auto slot = fresh.Next()) {
+      // begins lifetime of Node
+      auto node = std::construct_at(reinterpret_cast<Node*>(slot));
+      // well-defined
+      node->next = m_head;
+      m_head = node;
+    }
+  }
+
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (auto node = m_head; node != nullptr; node = node->next) {
+      fn(reinterpret_cast<T const*>(node));
+    }
+  }
+
+  // unlinks every free slot matching pred, keeps order of the rest
+  template <typename Pred>
+  void RemoveIf(Pred&& pred) {
+    auto link = &m_head;
+    while (*link != nullptr) {
+      if (pred(reinterpret_cast<T const*>(*link))) {
+        *link = (*link)->next;
+      } else {
+        link = &(*link)->next;
+      }
+    }
+  }
+
 public:
   struct Node {
     Node* next = nullptr;
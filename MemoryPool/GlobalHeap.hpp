@@ -0,0 +1,380 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "AlignUtils.hpp"
+#include "ConcurrentFreeList.hpp"
+#include "SizeClasses.hpp"
+#include "VirtualMemory.hpp"
+
+struct AllocationCounters {
+  std::uint64_t smallAllocations = 0;
+  std::uint64_t smallDeallocations = 0;
+  std::uint64_t largeAllocations = 0;
+  std::uint64_t largeDeallocations = 0;
+  // part of large ones that went to mmap
+  std::uint64_t mappedAllocations = 0;
+  // in slot or mapping granularity
+  std::uint64_t allocatedBytes = 0;
+  std::uint64_t deallocatedBytes = 0;
+  std::uint64_t failedAllocations = 0;
+  // traffic between thread caches and global lists
+  std::uint64_t cacheRefills = 0;
+  std::uint64_t cacheDrains = 0;
+  std::uint64_t chunksCarved = 0;
+};
+
+// Process-wide heap behind the replaced operator new/delete.
+// Small sizes: size classes, each carved from its own slice of one address
+// space reservation, so delete finds the class from the address alone.
+// Slots live in per-thread magazines backed by per-class LockFreeStacks.
+// Medium sizes go to malloc, large ones straight to mmap; both carry a
+// header in front of the block.
+// Nothing here may call operator new.
+class GlobalHeap {
+  static constexpr auto kClassCount = detail::kSizeClassCount;
+  static constexpr std::size_t kMagazineSize = 32;
+  static constexpr std::size_t kBatch = kMagazineSize / 2;
+  static constexpr std::size_t kShards = 16;
+
+  using Node = LockFreeStack::Node;
+
+  enum class Counter : std::size_t {
+    smallAllocations,
+    smallDeallocations,
+    largeAllocations,
+    largeDeallocations,
+    mappedAllocations,
+    allocatedBytes,
+    deallocatedBytes,
+    failedAllocations,
+    cacheRefills,
+    cacheDrains,
+    chunksCarved,
+    count
+  };
+
+  // relaxed increments on a mostly thread-private line
+  struct alignas(kCacheLineSize) CounterShard {
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::count)> values{};
+  };
+
+  struct alignas(kCacheLineSize) SizeClassState {
+    LockFreeStack stack;
+    std::atomic<std::size_t> carved{0};
+  };
+
+  struct Magazine {
+    std::size_t count;
+    std::array<Node*, kMagazineSize> slots;
+  };
+
+  enum class CacheState : std::uint8_t { fresh, active, dead };
+
+  // trivially destructible: stays usable while other thread_locals die
+  struct ThreadCache {
+    std::array<Magazine, kClassCount> magazines;
+    std::size_t shard;
+    CacheState state;
+  };
+
+  struct CacheFlusher {
+    bool armed;
+
+    CacheFlusher() noexcept : armed(false) {
+    }
+
+    void Arm() noexcept {
+      armed = true;
+    }
+
+    ~CacheFlusher() {
+      Instance().FlushThreadCache();
+      s_cache.state = CacheState::dead;
+    }
+  };
+
+  // in front of every medium and large block
+  struct Header {
+    // mapping length for mmap, requested size for malloc
+    std::size_t bytes;
+    void* base;
+  };
+
+ public:
+  static constexpr std::size_t kClassRegionSize = std::size_t{1} << 30;
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+  static constexpr std::size_t kMmapThreshold = 128 * 1024;
+
+  // never destroyed: delete may still run after static destructors
+  [[nodiscard]] static GlobalHeap& Instance() noexcept {
+    alignas(GlobalHeap) static std::byte storage[sizeof(GlobalHeap)];
+    static auto const heap = new (storage) GlobalHeap;
+    return *heap;
+  }
+
+  GlobalHeap(GlobalHeap const& other) = delete;
+  GlobalHeap& operator=(GlobalHeap const& other) = delete;
+
+ public:
+  // nullptr on failure, the caller decides between bad_alloc and nothrow
+  [[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment) noexcept {
+    auto const index = detail::SizeClassIndex(size, alignment);
+    if (index != kClassCount && m_base != nullptr) {
+      if (auto ptr = AllocateSmall(index)) {
+        Count(Counter::smallAllocations);
+        Count(Counter::allocatedBytes, detail::kSizeClasses[index].size);
+        return ptr;
+      }
+    }
+
+    auto ptr = AllocateLarge(size, alignment);
+    Count(ptr == nullptr ? Counter::failedAllocations : Counter::largeAllocations);
+    return ptr;
+  }
+
+  void Deallocate(void* ptr) noexcept {
+    if (ptr == nullptr) {
+      return;
+    }
+
+    // wraps around below m_base
+    auto const offset = reinterpret_cast<std::uintptr_t>(ptr) -
+                        reinterpret_cast<std::uintptr_t>(m_base);
+    if (m_base != nullptr && offset < kClassRegionSize * kClassCount) {
+      auto const index = offset / kClassRegionSize;
+      DeallocateSmall(index, ptr);
+      Count(Counter::smallDeallocations);
+      Count(Counter::deallocatedBytes, detail::kSizeClasses[index].size);
+      return;
+    }
+
+    DeallocateLarge(ptr);
+    Count(Counter::largeDeallocations);
+  }
+
+  // returns calling thread's cached slots to the global lists
+  void FlushThreadCache() noexcept {
+    auto& cache = s_cache;
+    if (cache.state != CacheState::active) {
+      return;
+    }
+    for (std::size_t index = 0; index < kClassCount; ++index) {
+      Drain(index, cache.magazines[index], cache.magazines[index].count);
+    }
+  }
+
+  // sums all shards, allocation keeps going meanwhile
+  [[nodiscard]] AllocationCounters Counters() const noexcept {
+    auto const sum = [this](Counter counter) {
+      std::uint64_t total = 0;
+      for (auto const& shard : m_counters) {
+        total += shard.values[static_cast<std::size_t>(counter)].load(
+            std::memory_order_relaxed);
+      }
+      return total;
+    };
+
+    return {.smallAllocations = sum(Counter::smallAllocations),
+            .smallDeallocations = sum(Counter::smallDeallocations),
+            .largeAllocations = sum(Counter::largeAllocations),
+            .largeDeallocations = sum(Counter::largeDeallocations),
+            .mappedAllocations = sum(Counter::mappedAllocations),
+            .allocatedBytes = sum(Counter::allocatedBytes),
+            .deallocatedBytes = sum(Counter::deallocatedBytes),
+            .failedAllocations = sum(Counter::failedAllocations),
+            .cacheRefills = sum(Counter::cacheRefills),
+            .cacheDrains = sum(Counter::cacheDrains),
+            .chunksCarved = sum(Counter::chunksCarved)};
+  }
+
+  void Dump(std::FILE* out) const noexcept {
+    auto const c = Counters();
+    std::fprintf(out,
+                 "small: %llu allocations, %llu deallocations\n"
+                 "large: %llu allocations (%llu mapped), %llu deallocations\n"
+                 "bytes: %llu allocated, %llu deallocated\n"
+                 "failed allocations: %llu\n"
+                 "cache: %llu refills, %llu drains, %llu chunks carved\n",
+                 static_cast<unsigned long long>(c.smallAllocations),
+                 static_cast<unsigned long long>(c.smallDeallocations),
+                 static_cast<unsigned long long>(c.largeAllocations),
+                 static_cast<unsigned long long>(c.mappedAllocations),
+                 static_cast<unsigned long long>(c.largeDeallocations),
+                 static_cast<unsigned long long>(c.allocatedBytes),
+                 static_cast<unsigned long long>(c.deallocatedBytes),
+                 static_cast<unsigned long long>(c.failedAllocations),
+                 static_cast<unsigned long long>(c.cacheRefills),
+                 static_cast<unsigned long long>(c.cacheDrains),
+                 static_cast<unsigned long long>(c.chunksCarved));
+  }
+
+ private:
+  GlobalHeap() noexcept
+      : m_base(static_cast<std::byte*>(vm::Reserve(kClassRegionSize * kClassCount))) {
+  }
+
+  // nullptr once the thread is past its thread_local destructors
+  static ThreadCache* LocalCache() noexcept {
+    auto& cache = s_cache;
+    if (cache.state == CacheState::fresh) [[unlikely]] {
+      s_flusher.Arm();
+      auto const index = detail::ThreadIndex::Get();
+      cache.shard = index == detail::ThreadIndex::kNone ? 0 : index % kShards;
+      cache.state = CacheState::active;
+    }
+    return cache.state == CacheState::active ? &cache : nullptr;
+  }
+
+  void Count(Counter counter, std::uint64_t value = 1) noexcept {
+    auto const shard = s_cache.state == CacheState::active ? s_cache.shard : 0;
+    m_counters[shard].values[static_cast<std::size_t>(counter)].fetch_add(
+        value, std::memory_order_relaxed);
+  }
+
+  void* AllocateSmall(std::size_t index) noexcept {
+    auto cache = LocalCache();
+    if (cache == nullptr) {
+      Node* node = nullptr;
+      if (m_classes[index].stack.PopChain(&node, 1) == 0) {
+        Carve(index, &node, 1);
+      }
+      return node;
+    }
+
+    auto& magazine = cache->magazines[index];
+    if (magazine.count == 0) {
+      Count(Counter::cacheRefills);
+      magazine.count = m_classes[index].stack.PopChain(magazine.slots.data(), kBatch);
+      if (magazine.count == 0) {
+        magazine.count = Carve(index, magazine.slots.data(), kBatch);
+        if (magazine.count == 0) {
+          return nullptr;
+        }
+      }
+    }
+    return magazine.slots[--magazine.count];
+  }
+
+  void DeallocateSmall(std::size_t index, void* ptr) noexcept {
+    // begins lifetime of Node
+    auto node = new (ptr) Node;
+    auto cache = LocalCache();
+    if (cache == nullptr) {
+      m_classes[index].stack.PushChain(node, node);
+      return;
+    }
+
+    auto& magazine = cache->magazines[index];
+    if (magazine.count == kMagazineSize) {
+      // the oldest slots go back, the hot ones stay
+      Drain(index, magazine, kBatch);
+    }
+    magazine.slots[magazine.count++] = node;
+  }
+
+  void Drain(std::size_t index, Magazine& magazine, std::size_t count) noexcept {
+    if (count == 0) {
+      return;
+    }
+    Count(Counter::cacheDrains);
+    auto const slots = magazine.slots.data();
+    LockFreeStack::Link(slots, count);
+    m_classes[index].stack.PushChain(slots[0], slots[count - 1]);
+    std::copy(slots + count, slots + magazine.count, slots);
+    magazine.count -= count;
+  }
+
+  // cuts a fresh chunk from the class region: up to count slots go to out,
+  // the rest to the global list. 0 when the region is used up
+  std::size_t Carve(std::size_t index, Node** out, std::size_t count) noexcept {
+    auto& state = m_classes[index];
+    auto const offset = state.carved.fetch_add(kChunkSize, std::memory_order_relaxed);
+    if (offset + kChunkSize > kClassRegionSize) {
+      return 0;
+    }
+    auto const chunk = m_base + index * kClassRegionSize + offset;
+    if (!vm::Commit(chunk, kChunkSize)) {
+      return 0;
+    }
+    Count(Counter::chunksCarved);
+
+    auto const slotSize = detail::kSizeClasses[index].size;
+    auto const slots = kChunkSize / slotSize;
+    auto const taken = slots < count ? slots : count;
+    for (std::size_t i = 0; i < taken; ++i) {
+      out[i] = reinterpret_cast<Node*>(chunk + i * slotSize);
+    }
+    if (taken == slots) {
+      return taken;
+    }
+
+    // begins lifetime of Node
+    Node* first = new (chunk + taken * slotSize) Node;
+    auto prev = first;
+    for (std::size_t i = taken + 1; i < slots; ++i) {
+      // begins lifetime of Node
+      auto node = new (chunk + i * slotSize) Node;
+      prev->next.store(node, std::memory_order_relaxed);
+      prev = node;
+    }
+    state.stack.PushChain(first, prev);
+    return taken;
+  }
+
+  void* AllocateLarge(std::size_t size, std::size_t alignment) noexcept {
+    alignment = alignment < alignof(Header) ? alignof(Header) : alignment;
+    // header + alignment slack, guards against overflow too
+    auto const extra = sizeof(Header) + alignment;
+    if (size > SIZE_MAX / 2 - extra) {
+      return nullptr;
+    }
+
+    // mappings are never shorter than kMmapThreshold, malloc blocks are
+    auto const mapped = size >= kMmapThreshold;
+    std::byte* base = nullptr;
+    std::size_t bytes = size;
+    if (mapped) {
+      auto const page = vm::PageSize();
+      bytes = (size + extra + page - 1) / page * page;
+      base = static_cast<std::byte*>(vm::Map(bytes));
+    } else {
+      base = static_cast<std::byte*>(std::malloc(size + extra));
+    }
+    if (base == nullptr) {
+      return nullptr;
+    }
+
+    auto const payload = Align(base + sizeof(Header), alignment);
+    *(reinterpret_cast<Header*>(payload) - 1) = {bytes, base};
+    if (mapped) {
+      Count(Counter::mappedAllocations);
+    }
+    Count(Counter::allocatedBytes, bytes);
+    return payload;
+  }
+
+  void DeallocateLarge(void* ptr) noexcept {
+    auto const header = *(static_cast<Header*>(ptr) - 1);
+    Count(Counter::deallocatedBytes, header.bytes);
+    if (header.bytes >= kMmapThreshold) {
+      vm::Release(header.base, header.bytes);
+    } else {
+      std::free(header.base);
+    }
+  }
+
+ private:
+  inline static thread_local constinit ThreadCache s_cache{};
+  inline static thread_local CacheFlusher s_flusher;
+
+  std::byte* const m_base;
+  std::array<SizeClassState, kClassCount> m_classes{};
+  std::array<CounterShard, kShards> m_counters{};
+};
@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+
+#include "SlotLayout.hpp"
+
+// LIFO over a bump pointer.
+// Slots above the high-water mark are handed out by bumping and never
+// touched before that, only freed slots go through the list.
+// Construction is O(1) and pages get committed on first use.
+template <typename T, typename SlotLayout = PackedLayout>
+class LazyFreeList {
+public:
+  using Layout = SlotLayout;
+
+  LazyFreeList() = delete;
+
+  explicit LazyFreeList(std::byte* begin, std::size_t space) noexcept
+      : m_fresh(begin, space) {
+  }
+
+  ~LazyFreeList() = default;
+
+  LazyFreeList(LazyFreeList const& other) = delete;
+  LazyFreeList& operator=(LazyFreeList const& other) = delete;
+  LazyFreeList(LazyFreeList&& other) noexcept = default;
+  LazyFreeList& operator=(LazyFreeList&& other) noexcept = default;
+
+public:
+  T * Pop() noexcept {
+    // recycled slots first, they are hot
+    if (auto head = m_head) {
+      m_head = head->next;
+      // let the user beware of lifetime
+      return reinterpret_cast<T *>(head);
+    }
+
+    return reinterpret_cast<T *>(m_fresh.Next());
+  }
+
+  void Push(T * ptr) noexcept {
+    // begins lifetime of Node
+    auto head = new (ptr) Node;
+    // well-defined
+    head->next = m_head;
+    m_head = head;
+  }
+
+  // same as up to count Pops, one write of each cursor
+  std::size_t PopBatch(T ** out, std::size_t count) noexcept {
+    std::size_t n = 0;
+    auto head = m_head;
+    for (; n < count && head != nullptr; ++n) {
+      // let the user beware of lifetime
+      out[n] = reinterpret_cast<T *>(head);
+      head = head->next;
+    }
+    m_head = head;
+
+    auto const bumped = std::min(count - n, m_fresh.Left());
+    for (std::size_t i = 0; i < bumped; ++i) {
+      out[n++] = reinterpret_cast<T *>(m_fresh.Next());
+    }
+    return n;
+  }
+
+  // same as Pushing ptrs in order, one head write
+  void PushBatch(T * const* ptrs, std::size_t count) noexcept {
+    auto head = m_head;
+    for (std::size_t i = 0; i < count; ++i) {
+      // begins lifetime of Node
+      auto node = new (ptrs[i]) Node;
+      // well-defined
+      node->next = head;
+      head = node;
+    }
+    m_head = head;
+  }
+
+  // new block becomes the bump region, the rest of the old one is threaded
+  void Extend(std::byte* begin, std::size_t space) noexcept {
+    Materialize();
+    m_fresh = {begin, space};
+  }
+
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (auto node = m_head; node != nullptr; node = node->next) {
+      fn(reinterpret_cast<T const*>(node));
+    }
+    m_fresh.ForEachLeft([&](std::byte const* slot) { fn(reinterpret_cast<T const*>(slot)); });
+  }
+
+  // Unlinks every free slot matching pred. The bump region is dropped
+  // whole if pred holds for all of it and left untouched if for none of
+  // it; only a split threads its kept slots.
+  template <typename Pred>
+  void RemoveIf(Pred&& pred) {
+    auto link = &m_head;
+    while (*link != nullptr) {
+      if (pred(reinterpret_cast<T const*>(*link))) {
+        *link = (*link)->next;
+      } else {
+        link = &(*link)->next;
+      }
+    }
+
+    std::size_t matching = 0;
+    m_fresh.ForEachLeft([&](std::byte const* slot) {
+      matching += pred(reinterpret_cast<T const*>(slot)) ? 1 : 0;
+    });
+    if (matching == m_fresh.Left()) {
+      m_fresh = {};
+    } else if (matching != 0) {
+      while (auto slot = m_fresh.Next()) {
+        if (!pred(reinterpret_cast<T const*>(slot))) {
+          Push(reinterpret_cast<T *>(slot));
+        }
+      }
+    }
+  }
+
+  // slots never handed out
+  [[nodiscard]] std::size_t Untouched() const noexcept {
+    return m_fresh.Left();
+  }
+
+public:
+  struct Node {
+    Node* next = nullptr;
+  };
+
+private:
+  // threads what is left above the high-water mark
+  void Materialize() noexcept {
+    while (auto slot = m_fresh.Next()) {
+      Push(reinterpret_cast<T *>(slot));
+    }
+  }
+
+private:
+  Node* m_head{nullptr};
+  SlotSequence<T, SlotLayout> m_fresh;
+};
@@ -1,18 +1,58 @@
 ﻿#pragma once
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <vector>
 
 #include "FreeList.hpp"
+#include "LazyFreeList.hpp"
+#include "PoolChecks.hpp"
+#include "PoolStats.hpp"
+#include "PoolStorage.hpp"
+#include "SlotLayout.hpp"
 
-template <typename T, typename FreeList = FreeList<T>>
-// :(
-// todo fix
-  requires(alignof(T) >= alignof(uintptr_t))
+// Geometric growth: an exhausted pool adds a slab of
+// capacity * (growthFactor - 1) slots, clamped by the limits below.
+// Slabs are never moved, so handed out pointers stay valid.
+struct GrowthPolicy {
+  double growthFactor = 2.0;
+  std::size_t minSlabSize = 1;
+  std::size_t maxSlabSize = std::numeric_limits<std::size_t>::max();
+  std::size_t maxCapacity = std::numeric_limits<std::size_t>::max();
+
+  // 0 when the pool may not grow anymore
+  [[nodiscard]] std::size_t NextSlabSize(std::size_t capacity) const noexcept {
+    if (capacity >= maxCapacity) {
+      return 0;
+    }
+    auto const wanted = static_cast<double>(capacity) * (growthFactor - 1.0);
+    auto slab = wanted >= static_cast<double>(maxSlabSize)
+                    ? maxSlabSize
+                    : std::max(static_cast<std::size_t>(wanted), minSlabSize);
+    return std::min({slab, maxSlabSize, maxCapacity - capacity});
+  }
+
+  [[nodiscard]] static constexpr GrowthPolicy Fixed() noexcept {
+    return {.maxCapacity = 0};
+  }
+};
+
+// slots are rounded up to hold a free list link, any T fits
+// slot size and order follow FreeList::Layout, see SlotLayout.hpp
+// Stats is NoStats or AtomicStats<>, see PoolStats.hpp
+// Storage backs the slabs, see PoolStorage.hpp
+// Checks is NoChecks or DebugChecks, see PoolChecks.hpp
+template <typename T, typename FreeList = LazyFreeList<T>, typename Stats = NoStats,
+          typename Storage = HeapStorage, typename Checks = NoChecks>
 class MemoryPool {
-  inline constinit static auto kAlignment = std::alignment_of_v<T>;
-  inline constinit static auto kSize = sizeof(T);
+  using Layout = typename SlotLayoutOf<FreeList>::Type;
+  inline constinit static auto kAlignment = Layout::template kAlignment<T>;
+  inline constinit static auto kSize = Layout::template kSize<T>;
 
  public:
   struct FreeBlockDeleter {
@@ -28,14 +68,29 @@ class MemoryPool {
 
  public:
   explicit MemoryPool(std::size_t size) noexcept
-      : m_data(static_cast<std::byte*>(operator new[](
-            size* kSize, std::align_val_t{kAlignment}))),
-        m_freeList(m_data, size) {
+      : MemoryPool(size, GrowthPolicy::Fixed()) {
+  }
+
+  MemoryPool(std::size_t size, GrowthPolicy growth) noexcept
+      : MemoryPool(size, growth, Storage{}) {
+  }
+
+  // Storage may round slabs up, the surplus becomes slots
+  MemoryPool(std::size_t size, GrowthPolicy growth, Storage storage) noexcept
+      : m_storage(std::move(storage)),
+        m_growth(growth),
+        m_slabs{AllocateSlab(size)},
+        m_freeList(m_slabs.front().data, m_slabs.front().size),
+        m_capacity(m_slabs.front().size) {
+    m_checks.OnSlab(m_slabs.front().data, m_slabs.front().size, kSize);
   }
 
   ~MemoryPool() noexcept {
     // it's up to user to return all ptrs for destruction
-    operator delete[](m_data, std::align_val_t{kAlignment});
+    m_checks.OnDestroy();
+    for (auto const& slab : m_slabs) {
+      FreeSlab(slab);
+    }
   }
 
   // Non-copyable
@@ -55,23 +110,31 @@ class MemoryPool {
   template <typename... U>
   [[nodiscard]] T* Allocate(U&&... args) noexcept(
       std::is_nothrow_constructible_v<T, U...>) {
-    auto freeBlock = m_freeList.Pop();
+    auto const start = m_stats.Start();
+    auto freeBlock = PopOrGrow();
     if (freeBlock == nullptr) {
+      m_stats.OnFailure();
       return nullptr;
     }
+    m_checks.OnPop(freeBlock, sizeof(T));
 
     // strong exception-safety guarantee
     try {
       new (freeBlock) T(std::forward<U>(args)...);
     } catch (std::exception& e) {
+      m_checks.OnPush(freeBlock, sizeof(T));
       m_freeList.Push(freeBlock);
+      m_stats.OnRollback();
       std::cout << e.what() << std::endl;
       return nullptr;
     } catch (...) {
+      m_checks.OnPush(freeBlock, sizeof(T));
       m_freeList.Push(freeBlock);
+      m_stats.OnRollback();
       return nullptr;
     }
 
+    m_stats.OnAllocate(start);
     return freeBlock;
   }
 
@@ -79,12 +142,16 @@ class MemoryPool {
   template <typename... U>
     requires std::is_nothrow_constructible_v<T, U...>
   [[nodiscard]] T* Allocate(U&&... args) noexcept {
-    auto freeBlock = m_freeList.Pop();
+    auto const start = m_stats.Start();
+    auto freeBlock = PopOrGrow();
     if (freeBlock == nullptr) {
+      m_stats.OnFailure();
       return nullptr;
     }
+    m_checks.OnPop(freeBlock, sizeof(T));
 
     new (freeBlock) T(std::forward<U>(args)...);
+    m_stats.OnAllocate(start);
     return freeBlock;
   }
 
@@ -94,9 +161,243 @@ class MemoryPool {
     return CreateUnique(Allocate(std::forward<U>(args)...));
   }
 
+  // All or nothing: fills every slot of ptrs with a T(args...) or returns
+  // false with nothing allocated. Constructed objects are destroyed again
+  // when a constructor throws.
+  template <typename... U>
+  [[nodiscard]] bool AllocateBatch(std::span<T*> ptrs, U const&... args) noexcept(
+      std::is_nothrow_constructible_v<T, U const&...>) {
+    auto const start = m_stats.Start();
+    auto const popped = PopOrGrowBatch(ptrs);
+    if (popped != ptrs.size()) {
+      PushBatch(ptrs.first(popped));
+      m_stats.OnFailure();
+      return false;
+    }
+    for (auto ptr : ptrs) {
+      m_checks.OnPop(ptr, sizeof(T));
+    }
+
+    if constexpr (std::is_nothrow_constructible_v<T, U const&...>) {
+      for (auto ptr : ptrs) {
+        new (ptr) T(args...);
+      }
+    } else {
+      std::size_t constructed = 0;
+      // strong exception-safety guarantee
+      try {
+        for (; constructed < ptrs.size(); ++constructed) {
+          new (ptrs[constructed]) T(args...);
+        }
+      } catch (...) {
+        for (auto ptr : ptrs.first(constructed)) {
+          std::destroy_at(ptr);
+        }
+        for (auto ptr : ptrs) {
+          m_checks.OnPush(ptr, sizeof(T));
+        }
+        PushBatch(ptrs);
+        m_stats.OnRollback();
+        return false;
+      }
+    }
+
+    m_stats.OnAllocate(start, ptrs.size());
+    return true;
+  }
+
+  void FreeBatch(std::span<T* const> ptrs) noexcept {
+    for (auto ptr : ptrs) {
+      m_checks.OnFree(ptr, sizeof(T));
+      std::destroy_at(ptr);
+      // before the slot is visible to other threads again
+      m_checks.OnPush(ptr, sizeof(T));
+    }
+    PushBatch(ptrs);
+    m_stats.OnFree(ptrs.size());
+  }
+
   void Free(T* ptr) noexcept {
+    m_checks.OnFree(ptr, sizeof(T));
     std::destroy_at(ptr);
+    // before the slot is visible to other threads again
+    m_checks.OnPush(ptr, sizeof(T));
     m_freeList.Push(ptr);
+    m_stats.OnFree();
+  }
+
+  [[nodiscard]] FreeList& GetFreeList() noexcept {
+    return m_freeList;
+  }
+
+  [[nodiscard]] Storage const& GetStorage() const noexcept {
+    return m_storage;
+  }
+
+  [[nodiscard]] Checks const& GetChecks() const noexcept {
+    return m_checks;
+  }
+
+  // safe to poll while other threads allocate
+  [[nodiscard]] Stats const& GetStats() const noexcept {
+    return m_stats;
+  }
+
+  // slots in all slabs
+  [[nodiscard]] std::size_t Capacity() const noexcept {
+    std::lock_guard lock{m_growMutex};
+    return m_capacity;
+  }
+
+  [[nodiscard]] std::size_t SlabCount() const noexcept {
+    std::lock_guard lock{m_growMutex};
+    return m_slabs.size();
+  }
+
+  // Memory-pressure hook: gives back every fully free slab but the initial
+  // one. Returns released slots. Walks the free list, so not for hot paths,
+  // and must not race with Allocate/Free.
+  std::size_t Trim() noexcept
+    requires TrimmableFreeList<FreeList, T>
+  {
+    std::lock_guard lock{m_growMutex};
+    // slabs sorted by address, except the initial one
+    auto const grown = std::span{m_slabs}.subspan(1);
+    auto const find = [grown](T const* ptr) -> Slab* {
+      auto const addr = reinterpret_cast<std::byte const*>(ptr);
+      auto it = std::ranges::upper_bound(grown, addr, std::less{}, &Slab::data);
+      if (it == grown.begin()) {
+        return nullptr;
+      }
+      auto& slab = *std::prev(it);
+      return addr < slab.data + slab.size * kSize ? &slab : nullptr;
+    };
+
+    for (auto& slab : grown) {
+      slab.free = 0;
+    }
+    m_freeList.ForEach([&](T const* ptr) {
+      if (auto slab = find(ptr)) {
+        ++slab->free;
+      }
+    });
+    m_freeList.RemoveIf([&](T const* ptr) {
+      auto slab = find(ptr);
+      return slab != nullptr && slab->free == slab->size;
+    });
+
+    std::size_t released = 0;
+    auto kept = grown.begin();
+    for (auto& slab : grown) {
+      if (slab.free == slab.size) {
+        released += slab.size;
+        m_checks.OnSlabRelease(slab.data);
+        FreeSlab(slab);
+      } else {
+        *kept++ = slab;
+      }
+    }
+    m_slabs.resize(m_slabs.size() - static_cast<std::size_t>(grown.end() - kept));
+    m_capacity -= released;
+    return released;
+  }
+
+ private:
+  struct Slab {
+    std::byte* data;
+    std::size_t size;
+    // as granted by Storage
+    std::size_t bytes;
+    // scratch for Trim
+    std::size_t free = 0;
+  };
+
+  [[nodiscard]] Slab AllocateSlab(std::size_t size) {
+    auto const block = m_storage.Allocate(size * kSize, kAlignment);
+    return {.data = block.data(), .size = block.size() / kSize, .bytes = block.size()};
+  }
+
+  void FreeSlab(Slab const& slab) noexcept {
+    m_storage.Deallocate({slab.data, slab.bytes}, kAlignment);
+  }
+
+  [[nodiscard]] T* PopOrGrow() noexcept {
+    if (auto freeBlock = m_freeList.Pop()) {
+      return freeBlock;
+    }
+    return Grow();
+  }
+
+  std::size_t PopBatch(std::span<T*> out) noexcept {
+    if constexpr (BatchFreeList<FreeList, T>) {
+      return m_freeList.PopBatch(out.data(), out.size());
+    } else {
+      std::size_t n = 0;
+      for (; n < out.size(); ++n) {
+        out[n] = m_freeList.Pop();
+        if (out[n] == nullptr) {
+          break;
+        }
+      }
+      return n;
+    }
+  }
+
+  void PushBatch(std::span<T* const> ptrs) noexcept {
+    if constexpr (BatchFreeList<FreeList, T>) {
+      m_freeList.PushBatch(ptrs.data(), ptrs.size());
+    } else {
+      for (auto ptr : ptrs) {
+        m_freeList.Push(ptr);
+      }
+    }
+  }
+
+  [[nodiscard]] std::size_t PopOrGrowBatch(std::span<T*> out) noexcept {
+    auto n = PopBatch(out);
+    while (n < out.size()) {
+      auto freeBlock = Grow();
+      if (freeBlock == nullptr) {
+        break;
+      }
+      out[n++] = freeBlock;
+      n += PopBatch(out.subspan(n));
+    }
+    return n;
+  }
+
+  // slow path, serialized: a racing thread may have grown the pool already
+  [[nodiscard]] T* Grow() noexcept {
+    std::lock_guard lock{m_growMutex};
+    if (auto freeBlock = m_freeList.Pop()) {
+      return freeBlock;
+    }
+
+    auto const size = m_growth.NextSlabSize(m_capacity);
+    if (size == 0) {
+      return nullptr;
+    }
+
+    try {
+      m_slabs.reserve(m_slabs.size() + 1);
+      auto const slab = AllocateSlab(size);
+      try {
+        m_checks.OnSlab(slab.data, slab.size, kSize);
+      } catch (...) {
+        FreeSlab(slab);
+        throw;
+      }
+      // keep grown slabs sorted by address for Trim
+      m_slabs.insert(std::ranges::upper_bound(m_slabs.begin() + 1, m_slabs.end(),
+                                              slab.data, std::less{}, &Slab::data),
+                     slab);
+      m_freeList.Extend(slab.data, slab.size);
+      m_capacity += slab.size;
+      m_stats.OnGrow(slab.size);
+    } catch (std::bad_alloc const&) {
+      return nullptr;
+    }
+    return m_freeList.Pop();
   }
 
  private:
@@ -109,8 +410,16 @@ class MemoryPool {
   }
 
  private:
-  std::byte* m_data;
+  // before m_slabs, which it allocates
+  [[no_unique_address]] Storage m_storage;
+  GrowthPolicy m_growth;
+  // the initial slab first, grown ones sorted by address
+  std::vector<Slab> m_slabs;
   FreeList m_freeList;
+  std::size_t m_capacity;
+  mutable std::mutex m_growMutex;
+  [[no_unique_address]] Stats m_stats;
+  [[no_unique_address]] Checks m_checks;
 };
 
 template <typename T, template <typename> typename FreeList>
@@ -1,60 +1,127 @@
-#include <cstdio>
 #include <new>
 
-#include "AlignedAlloc.hpp"
+#include "GlobalHeap.hpp"
 
-// no inline, required by [replacement.functions]/3
-void* operator new(std::size_t sz) {
-  std::printf("new(size_t), size = %zu\n", sz);
-  if (sz == 0) {
-    ++sz;  // avoid std::malloc(0) which may return nullptr on success
+namespace {
+// an object of size n never needs more than the largest power of two
+// dividing n, so small requests may go to the 8 byte class
+std::size_t DefaultAlignment(std::size_t sz) noexcept {
+  auto const natural = detail::NaturalAlignment(sz);
+  return natural != 0 && natural < __STDCPP_DEFAULT_NEW_ALIGNMENT__
+             ? natural
+             : __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+// loops over new_handler, required by [new.delete.single]/3
+void* Allocate(std::size_t sz, std::size_t alignment) {
+  auto& heap = GlobalHeap::Instance();
+  for (;;) {
+    if (void* ptr = heap.Allocate(sz, alignment)) {
+      return ptr;
+    }
+    auto const handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc{};
+    }
+    handler();
   }
+}
 
-  if (void* ptr = std::malloc(sz)) {
-    return ptr;
+void* AllocateNoThrow(std::size_t sz, std::size_t alignment) noexcept {
+  try {
+    return Allocate(sz, alignment);
+  } catch (...) {
+    return nullptr;
   }
+}
 
-  throw std::bad_alloc{};  // required by [new.delete.single]/3
+void Deallocate(void* ptr) noexcept {
+  GlobalHeap::Instance().Deallocate(ptr);
 }
+}  // namespace
 
-void* operator new[](std::size_t sz) {
-  std::printf("new[](size_t), size = %zu\n", sz);
-  if (sz == 0) {
-    ++sz;
-  }
+// no inline, required by [replacement.functions]/3
+void* operator new(std::size_t sz) {
+  return Allocate(sz, DefaultAlignment(sz));
+}
 
-  if (void* ptr = std::malloc(sz)) {
-    return ptr;
-  }
+void* operator new[](std::size_t sz) {
+  return Allocate(sz, DefaultAlignment(sz));
+}
 
-  throw std::bad_alloc{};
+void* operator new(std::size_t sz, std::align_val_t align) {
+  return Allocate(sz, static_cast<std::size_t>(align));
 }
 
 void* operator new[](std::size_t sz, std::align_val_t align) {
-  std::printf("new[](size_t, std::align_val_t), size = %zu\n", sz);
-  if (sz == 0) {
-    ++sz;
-  }
+  return Allocate(sz, static_cast<std::size_t>(align));
+}
 
-  if (void* ptr = ALIGNED_ALLOC(static_cast<size_t>(align), sz)) {
-    return ptr;
-  }
+void* operator new(std::size_t sz, std::nothrow_t const&) noexcept {
+  return AllocateNoThrow(sz, DefaultAlignment(sz));
+}
 
-  throw std::bad_alloc{};
+void* operator new[](std::size_t sz, std::nothrow_t const&) noexcept {
+  return AllocateNoThrow(sz, DefaultAlignment(sz));
 }
 
-void operator delete[](void* ptr,
-                       [[maybe_unused]] std::align_val_t align) noexcept {
-  std::puts("delete[](void*, std::align_val_t)");
-  ALIGNED_FREE(ptr);
+void* operator new(std::size_t sz, std::align_val_t align,
+                   std::nothrow_t const&) noexcept {
+  return AllocateNoThrow(sz, static_cast<std::size_t>(align));
 }
 
-void operator delete[](void* ptr) noexcept {
-  std::puts("delete[](void*)");
-  std::free(ptr);
+void* operator new[](std::size_t sz, std::align_val_t align,
+                     std::nothrow_t const&) noexcept {
+  return AllocateNoThrow(sz, static_cast<std::size_t>(align));
 }
 
+// the heap finds size and alignment from the pointer itself,
+// so every delete funnels into the same call
 void operator delete(void* ptr) noexcept {
-  std::puts("delete(void*)");
-  std::free(ptr);
-}
\ No newline at end of file
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::nothrow_t const&) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, std::nothrow_t const&) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t,
+                       std::nothrow_t const&) noexcept {
+  Deallocate(ptr);
+}
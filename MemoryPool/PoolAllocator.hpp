@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "SizeClassAllocator.hpp"
+
+// Stateful std::allocator replacement over a SizeClassAllocator (or anything
+// with the same Allocate/Deallocate). Rebinds share the backing allocator,
+// so list/map nodes and unordered_map buckets all come from its pools.
+// Names follow the Allocator requirements.
+// NOLINTBEGIN(readability-identifier-naming)
+template <typename T, typename Backing = SizeClassAllocator<>>
+class PoolAllocator {
+  template <typename U, typename B>
+  friend class PoolAllocator;
+
+ public:
+  using value_type = T;
+
+  explicit PoolAllocator(Backing& backing) noexcept
+      : m_backing(&backing) {
+  }
+
+  template <typename U>
+  PoolAllocator(PoolAllocator<U, Backing> const& other) noexcept
+      : m_backing(other.m_backing) {
+  }
+
+  [[nodiscard]] T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length{};
+    }
+    return static_cast<T*>(m_backing->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    m_backing->Deallocate(ptr, n * sizeof(T), alignof(T));
+  }
+
+  [[nodiscard]] Backing& GetBacking() const noexcept {
+    return *m_backing;
+  }
+
+  template <typename U>
+  friend bool operator==(PoolAllocator const& lhs,
+                         PoolAllocator<U, Backing> const& rhs) noexcept {
+    return &lhs.GetBacking() == &rhs.GetBacking();
+  }
+
+ private:
+  Backing* m_backing;
+};
+// NOLINTEND(readability-identifier-naming)
@@ -0,0 +1,240 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "SlotLayout.hpp"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define MEMORY_POOL_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define MEMORY_POOL_ASAN 1
+#endif
+#endif
+
+#ifdef MEMORY_POOL_ASAN
+#include <sanitizer/asan_interface.h>
+#endif
+
+// Checks policies for MemoryPool. The pool calls
+//   OnSlab(data, slots, stride) / OnSlabRelease(data) as slabs come and go,
+//   OnPop(slot, objectSize) before constructing into a slot it got from the
+//     free list,
+//   OnFree(ptr, objectSize) before destroying an object handed to Free,
+//   OnPush(slot, objectSize) before a slot goes back (Free or rollback),
+//   OnDestroy() from ~MemoryPool.
+// NoChecks compiles all of it away.
+
+struct NoChecks {
+  static void OnSlab(std::byte*, std::size_t, std::size_t) noexcept {
+  }
+
+  static void OnSlabRelease(std::byte*) noexcept {
+  }
+
+  static void OnPop(void*, std::size_t) noexcept {
+  }
+
+  static void OnFree(void*, std::size_t) noexcept {
+  }
+
+  static void OnPush(void*, std::size_t) noexcept {
+  }
+
+  static void OnDestroy() noexcept {
+  }
+};
+
+// Catches misuse at the call that does it and aborts with a message:
+//   pointers outside every slab or not at a slot boundary,
+//   double frees, through a state byte per slot,
+//   writes past the object into the rest of its slot (canary bytes),
+//   writes to freed slots (poison bytes, checked on reuse).
+// Freed slots and canaries are ASan-poisoned when built with ASan, and
+// ~MemoryPool reports leaked objects. Serialized by a mutex, debug only.
+// Canaries need slack after T, GuardedLayout guarantees some.
+class DebugChecks {
+ public:
+  static constexpr std::byte kCanary{0xCB};
+  static constexpr std::byte kPoison{0xDD};
+  // bytes the free list keeps its link in
+  static constexpr std::size_t kLinkSize = sizeof(std::uintptr_t);
+
+  void OnSlab(std::byte* data, std::size_t slots, std::size_t stride) {
+    std::lock_guard lock{m_mutex};
+    auto const slab = Slab{data, slots, stride, std::vector<State>(slots, State::fresh)};
+    m_slabs.insert(std::ranges::upper_bound(m_slabs, data, std::less{}, &Slab::data), slab);
+  }
+
+  void OnSlabRelease(std::byte* data) noexcept {
+    std::lock_guard lock{m_mutex};
+    auto it = std::ranges::find(m_slabs, data, &Slab::data);
+    if (it != m_slabs.end()) {
+      Unpoison(it->data, it->size * it->stride);
+      m_slabs.erase(it);
+    }
+  }
+
+  void OnPop(void* slot, std::size_t objectSize) noexcept {
+    std::lock_guard lock{m_mutex};
+    auto [slab, index] = Find(slot, "Allocate got a slot");
+    auto& state = slab->states[index];
+    if (state == State::live) {
+      Fail("free list handed out a live slot", slot);
+    }
+    auto const bytes = static_cast<std::byte*>(slot);
+    Unpoison(bytes, slab->stride);
+    if (state == State::free &&
+        !Filled(bytes + kLinkSize, bytes + slab->stride, kPoison)) {
+      Fail("write to a freed slot", slot);
+    }
+    state = State::live;
+    // lock-free lists may still read the link of a slot just popped
+    auto const guard = GuardStart(objectSize, slab->stride);
+    Fill(bytes + guard, bytes + slab->stride, kCanary);
+    Poison(bytes + guard, slab->stride - guard);
+  }
+
+  void OnFree(void* ptr, std::size_t objectSize) noexcept {
+    std::lock_guard lock{m_mutex};
+    auto [slab, index] = Find(ptr, "Free");
+    if (slab->states[index] != State::live) {
+      Fail("double free", ptr);
+    }
+    auto const bytes = static_cast<std::byte*>(ptr);
+    Unpoison(bytes, slab->stride);
+    if (!Filled(bytes + GuardStart(objectSize, slab->stride), bytes + slab->stride, kCanary)) {
+      Fail("buffer overflow, canary after the object is gone", ptr);
+    }
+  }
+
+  void OnPush(void* slot, std::size_t) noexcept {
+    std::lock_guard lock{m_mutex};
+    auto [slab, index] = Find(slot, "Free");
+    slab->states[index] = State::free;
+    auto const bytes = static_cast<std::byte*>(slot);
+    // the free list owns the first word, the rest must stay untouched
+    Unpoison(bytes, kLinkSize);
+    Fill(bytes + kLinkSize, bytes + slab->stride, kPoison);
+    Poison(bytes + kLinkSize, slab->stride - kLinkSize);
+  }
+
+  void OnDestroy() noexcept {
+    if (auto const leaks = Live(); leaks != 0) {
+      std::fprintf(stderr, "MemoryPool: %zu object(s) leaked\n", leaks);
+      std::size_t shown = 0;
+      ForEachLive([&](void const* ptr) {
+        if (shown++ < kShownLeaks) {
+          std::fprintf(stderr, "  %p\n", ptr);
+        }
+      });
+    }
+    std::lock_guard lock{m_mutex};
+    for (auto const& slab : m_slabs) {
+      Unpoison(slab.data, slab.size * slab.stride);
+    }
+  }
+
+  // objects handed out and not freed yet
+  [[nodiscard]] std::size_t Live() const noexcept {
+    std::size_t live = 0;
+    ForEachLive([&](void const*) { ++live; });
+    return live;
+  }
+
+  template <typename Fn>
+  void ForEachLive(Fn&& fn) const {
+    std::lock_guard lock{m_mutex};
+    for (auto const& slab : m_slabs) {
+      for (std::size_t i = 0; i < slab.size; ++i) {
+        if (slab.states[i] == State::live) {
+          fn(static_cast<void const*>(slab.data + i * slab.stride));
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr std::size_t kShownLeaks = 16;
+
+  enum class State : std::uint8_t { fresh, live, free };
+
+  struct Slab {
+    std::byte* data;
+    std::size_t size;
+    std::size_t stride;
+    std::vector<State> states;
+  };
+
+  // canaries start after the object and never cover the link word
+  static std::size_t GuardStart(std::size_t objectSize, std::size_t stride) noexcept {
+    return std::min(std::max(objectSize, kLinkSize), stride);
+  }
+
+  [[noreturn]] static void Fail(char const* what, void const* ptr) noexcept {
+    std::fprintf(stderr, "MemoryPool: %s at %p\n", what, ptr);
+    std::abort();
+  }
+
+  std::pair<Slab*, std::size_t> Find(void const* ptr, char const* call) noexcept {
+    auto const addr = static_cast<std::byte const*>(ptr);
+    auto it = std::ranges::upper_bound(m_slabs, addr, std::less{}, &Slab::data);
+    if (it != m_slabs.begin()) {
+      auto& slab = *std::prev(it);
+      auto const offset = static_cast<std::size_t>(addr - slab.data);
+      if (offset < slab.size * slab.stride) {
+        if (offset % slab.stride != 0) {
+          std::fprintf(stderr, "MemoryPool: %s: ", call);
+          Fail("pointer into the middle of a slot", ptr);
+        }
+        return {&slab, offset / slab.stride};
+      }
+    }
+    std::fprintf(stderr, "MemoryPool: %s: ", call);
+    Fail("pointer does not belong to the pool", ptr);
+  }
+
+  static void Fill(std::byte* begin, std::byte* end, std::byte value) noexcept {
+    if (begin < end) {
+      std::memset(begin, static_cast<int>(value), static_cast<std::size_t>(end - begin));
+    }
+  }
+
+  [[nodiscard]] static bool Filled(std::byte const* begin, std::byte const* end,
+                                   std::byte value) noexcept {
+    return std::all_of(begin, std::max(begin, end), [value](std::byte b) { return b == value; });
+  }
+
+  static void Poison([[maybe_unused]] void const* ptr, [[maybe_unused]] std::size_t bytes) noexcept {
+#ifdef MEMORY_POOL_ASAN
+    ASAN_POISON_MEMORY_REGION(ptr, bytes);
+#endif
+  }
+
+  static void Unpoison([[maybe_unused]] void const* ptr, [[maybe_unused]] std::size_t bytes) noexcept {
+#ifdef MEMORY_POOL_ASAN
+    ASAN_UNPOISON_MEMORY_REGION(ptr, bytes);
+#endif
+  }
+
+ private:
+  mutable std::mutex m_mutex;
+  // sorted by address
+  std::vector<Slab> m_slabs;
+};
+
+// Base with at least kGuardSize slack bytes after every T, for canaries
+template <typename Base = PackedLayout, std::size_t kGuardSize = sizeof(std::uintptr_t)>
+struct GuardedLayout : Base {
+  template <typename T>
+  static constexpr std::size_t kSize =
+      std::max(Base::template kSize<T>,
+               (sizeof(T) + kGuardSize + Base::template kAlignment<T> - 1) /
+                   Base::template kAlignment<T> * Base::template kAlignment<T>);
+};
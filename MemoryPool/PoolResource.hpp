@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+#include "SizeClassAllocator.hpp"
+
+// std::pmr face of SizeClassAllocator, for pmr containers and
+// as upstream of std::pmr pool resources
+template <template <typename> typename FreeList = LazyFreeList>
+class PoolResource : public std::pmr::memory_resource {
+ public:
+  explicit PoolResource(
+      std::size_t slabBytes = SizeClassAllocator<FreeList>::kDefaultSlabBytes,
+      GrowthPolicy growth = {})
+      : m_allocator(slabBytes, growth) {
+  }
+
+  [[nodiscard]] SizeClassAllocator<FreeList>& GetAllocator() noexcept {
+    return m_allocator;
+  }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return m_allocator.Allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr, std::size_t bytes,
+                     std::size_t alignment) override {
+    m_allocator.Deallocate(ptr, bytes, alignment);
+  }
+
+  // slots of one allocator can't go to another
+  [[nodiscard]] bool do_is_equal(
+      std::pmr::memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  SizeClassAllocator<FreeList> m_allocator;
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Stats policies for MemoryPool. The pool calls
+//   Start() before Allocate and passes its result to OnAllocate,
+//   OnAllocate / OnFailure (nullptr returned) / OnRollback (T's ctor threw),
+//   OnFree and OnGrow(slots). Batch calls pass their size as count and make
+//   a single latency sample.
+// NoStats compiles all of it away.
+
+inline constexpr std::size_t kLatencyBuckets = 32;
+
+// point-in-time copy, counters may move on while it is taken
+struct PoolStatsSnapshot {
+  std::uint64_t allocations = 0;
+  std::uint64_t deallocations = 0;
+  std::uint64_t failures = 0;
+  std::uint64_t rollbacks = 0;
+  std::uint64_t growths = 0;
+  std::uint64_t grownSlots = 0;
+  std::uint64_t live = 0;
+  std::uint64_t highWater = 0;
+  // bucket i counts allocations of [2^(i-1), 2^i) ns, all zero when disabled
+  std::array<std::uint64_t, kLatencyBuckets> latency{};
+};
+
+struct NoStats {
+  struct Token {};
+
+  static Token Start() noexcept {
+    return {};
+  }
+
+  static void OnAllocate(Token, std::size_t = 1) noexcept {
+  }
+
+  static void OnFailure() noexcept {
+  }
+
+  static void OnRollback() noexcept {
+  }
+
+  static void OnFree(std::size_t = 1) noexcept {
+  }
+
+  static void OnGrow(std::size_t) noexcept {
+  }
+};
+
+// Relaxed atomic counters, safe to Snapshot() while other threads allocate.
+// TrackLatency adds two clock reads per Allocate.
+template <bool TrackLatency = false>
+class AtomicStats {
+  using Clock = std::chrono::steady_clock;
+
+ public:
+  using Token = std::conditional_t<TrackLatency, Clock::time_point, NoStats::Token>;
+
+  static Token Start() noexcept {
+    if constexpr (TrackLatency) {
+      return Clock::now();
+    } else {
+      return {};
+    }
+  }
+
+  void OnAllocate([[maybe_unused]] Token start, std::size_t count = 1) noexcept {
+    m_allocations.fetch_add(count, std::memory_order_relaxed);
+    auto const live = m_live.fetch_add(count, std::memory_order_relaxed) + count;
+    auto highWater = m_highWater.load(std::memory_order_relaxed);
+    while (live > highWater &&
+           !m_highWater.compare_exchange_weak(highWater, live, std::memory_order_relaxed)) {
+    }
+
+    if constexpr (TrackLatency) {
+      auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+      auto const bucket = static_cast<std::size_t>(
+          std::bit_width(static_cast<std::uint64_t>(ns.count())));
+      m_latency[bucket < kLatencyBuckets ? bucket : kLatencyBuckets - 1].fetch_add(
+          1, std::memory_order_relaxed);
+    }
+  }
+
+  void OnFailure() noexcept {
+    m_failures.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void OnRollback() noexcept {
+    m_rollbacks.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void OnFree(std::size_t count = 1) noexcept {
+    m_deallocations.fetch_add(count, std::memory_order_relaxed);
+    m_live.fetch_sub(count, std::memory_order_relaxed);
+  }
+
+  void OnGrow(std::size_t slots) noexcept {
+    m_growths.fetch_add(1, std::memory_order_relaxed);
+    m_grownSlots.fetch_add(slots, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] PoolStatsSnapshot Snapshot() const noexcept {
+    PoolStatsSnapshot snapshot{
+        .allocations = m_allocations.load(std::memory_order_relaxed),
+        .deallocations = m_deallocations.load(std::memory_order_relaxed),
+        .failures = m_failures.load(std::memory_order_relaxed),
+        .rollbacks = m_rollbacks.load(std::memory_order_relaxed),
+        .growths = m_growths.load(std::memory_order_relaxed),
+        .grownSlots = m_grownSlots.load(std::memory_order_relaxed),
+        .live = m_live.load(std::memory_order_relaxed),
+        .highWater = m_highWater.load(std::memory_order_relaxed)};
+    if constexpr (TrackLatency) {
+      for (std::size_t i = 0; i < kLatencyBuckets; ++i) {
+        snapshot.latency[i] = m_latency[i].load(std::memory_order_relaxed);
+      }
+    }
+    return snapshot;
+  }
+
+ private:
+  struct Empty {};
+  using Histogram = std::conditional_t<TrackLatency,
+                                       std::array<std::atomic<std::uint64_t>, kLatencyBuckets>,
+                                       Empty>;
+
+  std::atomic<std::uint64_t> m_allocations{0};
+  std::atomic<std::uint64_t> m_deallocations{0};
+  std::atomic<std::uint64_t> m_failures{0};
+  std::atomic<std::uint64_t> m_rollbacks{0};
+  std::atomic<std::uint64_t> m_growths{0};
+  std::atomic<std::uint64_t> m_grownSlots{0};
+  std::atomic<std::uint64_t> m_live{0};
+  std::atomic<std::uint64_t> m_highWater{0};
+  [[no_unique_address]] Histogram m_latency{};
+};
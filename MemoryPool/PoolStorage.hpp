@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+#include "VirtualMemory.hpp"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Backing store policies for MemoryPool slabs:
+//   std::span<std::byte> Allocate(bytes, alignment), throws std::bad_alloc,
+//     may hand out more than asked, the pool turns it into slots;
+//   void Deallocate(span, alignment) with the span Allocate returned.
+
+// operator new[], what MemoryPool always did
+struct HeapStorage {
+  [[nodiscard]] static std::span<std::byte> Allocate(std::size_t bytes,
+                                                     std::size_t alignment) {
+    return {static_cast<std::byte*>(operator new[](bytes, std::align_val_t{alignment})),
+            bytes};
+  }
+
+  static void Deallocate(std::span<std::byte> block, std::size_t alignment) noexcept {
+    operator delete[](block.data(), std::align_val_t{alignment});
+  }
+};
+
+// Anonymous mappings with huge pages, NUMA placement and prefaulting.
+// Every request degrades gracefully: no hugetlbfs pages, THP disabled or
+// no such node leave a plain mapping behind. Linux only, elsewhere it is
+// page granular vm::Map.
+class PageStorage {
+ public:
+  static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+  static constexpr int kAnyNode = -1;
+
+  enum class HugePages : std::uint8_t {
+    none,
+    // transparent huge pages, 2 MiB aligned mapping + MADV_HUGEPAGE
+    transparent,
+    // MAP_HUGETLB from the reserved pool, transparent when it is empty
+    reserved
+  };
+
+  struct Options {
+    HugePages hugePages = HugePages::transparent;
+    // mbind(MPOL_BIND) before first touch
+    int numaNode = kAnyNode;
+    // commit every page up front instead of on first touch
+    bool prefault = false;
+  };
+
+  PageStorage() noexcept : PageStorage(Options{}) {
+  }
+
+  explicit PageStorage(Options options) noexcept : m_options(options) {
+  }
+
+  [[nodiscard]] std::span<std::byte> Allocate(std::size_t bytes, std::size_t alignment) {
+    auto const huge = m_options.hugePages != HugePages::none;
+    auto const granularity = huge ? kHugePageSize : vm::PageSize();
+    auto const length = (bytes + granularity - 1) / granularity * granularity;
+
+    void* ptr = nullptr;
+    Mapping mapping{};
+#ifdef __linux__
+    // mappings come granularity aligned, more takes over-mapping
+    auto const aligned = std::max(alignment, granularity);
+    if (m_options.hugePages == HugePages::reserved && aligned == kHugePageSize) {
+      ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (ptr == MAP_FAILED) {
+        ptr = nullptr;
+      } else {
+        mapping.hugeTlb = true;
+      }
+    }
+    if (ptr == nullptr) {
+      ptr = aligned > vm::PageSize() ? MapAligned(length, aligned) : vm::Map(length);
+      if (ptr != nullptr && huge) {
+        // a hint, fails with THP compiled out
+        madvise(ptr, length, MADV_HUGEPAGE);
+      }
+    }
+    if (ptr != nullptr && m_options.numaNode != kAnyNode) {
+      mapping.bound = Bind(ptr, length, m_options.numaNode);
+    }
+    if (ptr != nullptr && m_options.prefault) {
+      Prefault(ptr, length);
+    }
+#else
+    assert(alignment <= granularity && "PageStorage: alignment above the page size");
+    ptr = vm::Map(length);
+#endif
+    if (ptr == nullptr) {
+      throw std::bad_alloc{};
+    }
+    if (mapping.hugeTlb || mapping.bound) {
+      mapping.data = static_cast<std::byte*>(ptr);
+      try {
+        m_mappings.push_back(mapping);
+      } catch (...) {
+        vm::Release(ptr, length);
+        throw;
+      }
+      m_hugeTlbBytes += mapping.hugeTlb ? length : 0;
+      m_boundBytes += mapping.bound ? length : 0;
+    }
+    m_mappedBytes += length;
+    return {static_cast<std::byte*>(ptr), length};
+  }
+
+  void Deallocate(std::span<std::byte> block, std::size_t) noexcept {
+    m_mappedBytes -= block.size();
+    auto const it = std::ranges::find(m_mappings, block.data(), &Mapping::data);
+    if (it != m_mappings.end()) {
+      m_hugeTlbBytes -= it->hugeTlb ? block.size() : 0;
+      m_boundBytes -= it->bound ? block.size() : 0;
+      *it = m_mappings.back();
+      m_mappings.pop_back();
+    }
+    vm::Release(block.data(), block.size());
+  }
+
+  [[nodiscard]] Options const& GetOptions() const noexcept {
+    return m_options;
+  }
+
+  // what is mapped right now, not synchronized with a growing pool
+  [[nodiscard]] std::size_t MappedBytes() const noexcept {
+    return m_mappedBytes;
+  }
+
+  [[nodiscard]] std::size_t HugeTlbBytes() const noexcept {
+    return m_hugeTlbBytes;
+  }
+
+  [[nodiscard]] std::size_t BoundBytes() const noexcept {
+    return m_boundBytes;
+  }
+
+ private:
+#ifdef __linux__
+  // over-maps and trims both ends, so THP can back the whole range
+  static void* MapAligned(std::size_t length, std::size_t alignment) noexcept {
+    auto const raw = static_cast<std::byte*>(vm::Map(length + alignment));
+    if (raw == nullptr) {
+      return nullptr;
+    }
+    auto const aligned = reinterpret_cast<std::byte*>(
+        (reinterpret_cast<std::uintptr_t>(raw) + alignment - 1) & ~(alignment - 1));
+    if (aligned != raw) {
+      munmap(raw, static_cast<std::size_t>(aligned - raw));
+    }
+    auto const tail = static_cast<std::size_t>(raw + alignment - aligned);
+    if (tail != 0) {
+      munmap(aligned + length, tail);
+    }
+    return aligned;
+  }
+
+  // raw syscall: no libnuma dependency
+  static bool Bind(void* ptr, std::size_t length, int node) noexcept {
+    constexpr int kMpolBind = 2;
+    constexpr std::size_t kMaxNodes = 1024;
+    constexpr std::size_t kWordBits = 8 * sizeof(unsigned long);
+    if (node < 0 || static_cast<std::size_t>(node) >= kMaxNodes) {
+      return false;
+    }
+    unsigned long mask[kMaxNodes / kWordBits] = {};
+    mask[node / kWordBits] = 1ul << (node % kWordBits);
+    return syscall(SYS_mbind, ptr, length, kMpolBind, mask, kMaxNodes, 0) == 0;
+  }
+
+  static void Prefault(void* ptr, std::size_t length) noexcept {
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(ptr, length, MADV_POPULATE_WRITE) == 0) {
+      return;
+    }
+#endif
+    // older kernels: fresh anonymous memory is zero, writing zero is safe
+    auto const page = vm::PageSize();
+    for (std::size_t offset = 0; offset < length; offset += page) {
+      static_cast<std::byte volatile*>(ptr)[offset] = std::byte{0};
+    }
+  }
+#endif
+
+ private:
+  // a block that is counted in HugeTlbBytes or BoundBytes
+  struct Mapping {
+    std::byte* data = nullptr;
+    bool hugeTlb = false;
+    bool bound = false;
+  };
+
+ private:
+  Options m_options;
+  // plain mappings aren't recorded
+  std::vector<Mapping> m_mappings;
+  std::size_t m_mappedBytes = 0;
+  std::size_t m_hugeTlbBytes = 0;
+  std::size_t m_boundBytes = 0;
+};
@@ -0,0 +1,195 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "SlotLayout.hpp"
+
+// Single-owner free list that also takes frees from foreign threads.
+// The owner works like LazyFreeList: LIFO over a bump pointer, no atomics.
+// Foreign Push goes to a lock-free MPSC stack; once the local list runs dry
+// the owner takes the whole stack with one exchange, which becomes the new
+// local list. Pop, Extend and RemoveIf are owner only.
+template <typename T, typename SlotLayout = PackedLayout>
+class RemoteFreeList {
+public:
+  using Layout = SlotLayout;
+
+  RemoteFreeList() = delete;
+
+  // the constructing thread owns the list
+  explicit RemoteFreeList(std::byte* begin, std::size_t space) noexcept
+      : m_owner(std::this_thread::get_id()),
+        m_fresh(begin, space) {
+  }
+
+  ~RemoteFreeList() = default;
+
+  RemoteFreeList(RemoteFreeList const& other) = delete;
+  RemoteFreeList& operator=(RemoteFreeList const& other) = delete;
+  RemoteFreeList(RemoteFreeList&& other) noexcept = delete;
+  RemoteFreeList& operator=(RemoteFreeList&& other) noexcept = delete;
+
+public:
+  T * Pop() noexcept {
+    if (m_head == nullptr) {
+      Drain();
+    }
+    // recycled slots first, they are hot
+    if (auto head = m_head) {
+      m_head = head->next;
+      // let the user beware of lifetime
+      return reinterpret_cast<T *>(head);
+    }
+
+    return reinterpret_cast<T *>(m_fresh.Next());
+  }
+
+  // any thread
+  void Push(T * ptr) noexcept {
+    // begins lifetime of Node
+    auto node = new (ptr) Node;
+    if (IsOwner()) {
+      node->next = m_head;
+      m_head = node;
+    } else {
+      PushRemote(node, node);
+    }
+  }
+
+  // same as up to count Pops
+  std::size_t PopBatch(T ** out, std::size_t count) noexcept {
+    std::size_t n = 0;
+    for (; n < count; ++n) {
+      out[n] = Pop();
+      if (out[n] == nullptr) {
+        break;
+      }
+    }
+    return n;
+  }
+
+  // any thread, a foreign batch costs a single CAS
+  void PushBatch(T * const* ptrs, std::size_t count) noexcept {
+    if (count == 0) {
+      return;
+    }
+    // same order as Pushing ptrs one by one
+    // begins lifetime of Node
+    Node* last = new (ptrs[0]) Node;
+    Node* first = last;
+    for (std::size_t i = 1; i < count; ++i) {
+      // begins lifetime of Node
+      auto node = new (ptrs[i]) Node;
+      node->next = first;
+      first = node;
+    }
+
+    if (IsOwner()) {
+      last->next = m_head;
+      m_head = first;
+    } else {
+      PushRemote(first, last);
+    }
+  }
+
+  // new block becomes the bump region, the rest of the old one is threaded
+  void Extend(std::byte* begin, std::size_t space) noexcept {
+    Materialize();
+    m_fresh = {begin, space};
+  }
+
+  // owner only, sees remote frees made before the call
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (auto node = m_head; node != nullptr; node = node->next) {
+      fn(reinterpret_cast<T const*>(node));
+    }
+    // pushes only prepend, the chain below a loaded head never changes
+    for (auto node = m_remote.load(std::memory_order_acquire); node != nullptr;
+         node = node->next) {
+      fn(reinterpret_cast<T const*>(node));
+    }
+    m_fresh.ForEachLeft([&](std::byte const* slot) { fn(reinterpret_cast<T const*>(slot)); });
+  }
+
+  // owner only, takes remote frees in first
+  template <typename Pred>
+  void RemoveIf(Pred&& pred) {
+    Drain();
+    Materialize();
+    auto link = &m_head;
+    while (*link != nullptr) {
+      if (pred(reinterpret_cast<T const*>(*link))) {
+        *link = (*link)->next;
+      } else {
+        link = &(*link)->next;
+      }
+    }
+  }
+
+  // hands the list to the calling thread, must not race with anything
+  void Adopt() noexcept {
+    m_owner = std::this_thread::get_id();
+  }
+
+  [[nodiscard]] bool IsOwner() const noexcept {
+    return std::this_thread::get_id() == m_owner;
+  }
+
+  // slots never handed out
+  [[nodiscard]] std::size_t Untouched() const noexcept {
+    return m_fresh.Left();
+  }
+
+public:
+  struct Node {
+    Node* next = nullptr;
+  };
+
+private:
+  // next links are written before the release CAS publishes them
+  void PushRemote(Node* first, Node* last) noexcept {
+    auto head = m_remote.load(std::memory_order_relaxed);
+    do {
+      last->next = head;
+    } while (!m_remote.compare_exchange_weak(head, first, std::memory_order_release,
+                                             std::memory_order_relaxed));
+  }
+
+  // appends every remote free to the local list
+  void Drain() noexcept {
+    // cheap check first, exchange dirties the line
+    if (m_remote.load(std::memory_order_relaxed) == nullptr) {
+      return;
+    }
+    auto chain = m_remote.exchange(nullptr, std::memory_order_acquire);
+    if (m_head == nullptr) {
+      m_head = chain;
+      return;
+    }
+    auto tail = chain;
+    while (tail->next != nullptr) {
+      tail = tail->next;
+    }
+    tail->next = m_head;
+    m_head = chain;
+  }
+
+  // threads what is left above the high-water mark
+  void Materialize() noexcept {
+    while (auto slot = m_fresh.Next()) {
+      // begins lifetime of Node
+      auto node = new (slot) Node;
+      node->next = m_head;
+      m_head = node;
+    }
+  }
+
+private:
+  std::thread::id m_owner;
+  Node* m_head{nullptr};
+  SlotSequence<T, SlotLayout> m_fresh;
+  // own line: foreign threads hammer it, the owner rarely looks
+  alignas(kCacheLineSize) std::atomic<Node*> m_remote{nullptr};
+};
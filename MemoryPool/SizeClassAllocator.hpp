@@ -0,0 +1,131 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "LazyFreeList.hpp"
+#include "MemoryPool.hpp"
+#include "SizeClasses.hpp"
+
+
+// General purpose small-object allocator: a table of segregated growable
+// pools, one per size class. Requests are rounded up to the smallest class
+// that fits both size and alignment; bigger ones go to operator new.
+// Thread safety is the one of FreeList.
+template <template <typename> typename FreeList = LazyFreeList>
+class SizeClassAllocator {
+  static constexpr auto kClassCount = detail::kSizeClassCount;
+
+  template <std::size_t I>
+  using Slot = detail::SizeClassSlot<detail::kSizeClasses[I].size,
+                                     detail::kSizeClasses[I].alignment>;
+
+  template <std::size_t I>
+  using Pool = MemoryPool<Slot<I>, FreeList<Slot<I>>>;
+
+  // pools are neither copyable nor movable, so no std::tuple
+  template <std::size_t I>
+  struct PoolHolder {
+    Pool<I> pool;
+
+    PoolHolder(std::size_t slabBytes, GrowthPolicy growth)
+        : pool(std::max<std::size_t>(1, slabBytes / sizeof(Slot<I>)), growth) {
+    }
+  };
+
+  template <typename Sequence>
+  struct PoolTable;
+
+  template <std::size_t... I>
+  struct PoolTable<std::index_sequence<I...>> : PoolHolder<I>... {
+    PoolTable(std::size_t slabBytes, GrowthPolicy growth)
+        : PoolHolder<I>(slabBytes, growth)... {
+    }
+
+    template <std::size_t J>
+    Pool<J>& Get() noexcept {
+      return static_cast<PoolHolder<J>&>(*this).pool;
+    }
+  };
+
+  using Pools = PoolTable<std::make_index_sequence<kClassCount>>;
+
+ public:
+  static constexpr std::size_t kMaxSize = detail::kMaxSizeClass;
+  static constexpr std::size_t kMaxAlignment = detail::kMaxSizeClassAlignment;
+  static constexpr std::size_t kDefaultSlabBytes = 64 * 1024;
+
+  // every class starts with a slab of about slabBytes and grows by policy
+  explicit SizeClassAllocator(std::size_t slabBytes = kDefaultSlabBytes,
+                              GrowthPolicy growth = {})
+      : m_pools(slabBytes, growth) {
+  }
+
+  SizeClassAllocator(SizeClassAllocator const& other) = delete;
+  SizeClassAllocator& operator=(SizeClassAllocator const& other) = delete;
+  SizeClassAllocator(SizeClassAllocator&& other) noexcept = delete;
+  SizeClassAllocator& operator=(SizeClassAllocator&& other) noexcept = delete;
+
+ public:
+  // throws std::bad_alloc like operator new
+  [[nodiscard]] void* Allocate(
+      std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    auto const index = ClassIndex(size, alignment);
+    if (index == kClassCount) {
+      return operator new(size, std::align_val_t{alignment});
+    }
+    if (auto ptr = kAllocate[index](m_pools)) {
+      return ptr;
+    }
+    throw std::bad_alloc{};
+  }
+
+  // size and alignment must be the ones given to Allocate
+  void Deallocate(void* ptr, std::size_t size,
+                  std::size_t alignment = alignof(std::max_align_t)) noexcept {
+    auto const index = ClassIndex(size, alignment);
+    if (index == kClassCount) {
+      operator delete(ptr, size, std::align_val_t{alignment});
+      return;
+    }
+    kDeallocate[index](m_pools, ptr);
+  }
+
+  // bytes handed out for such a request, 0 when served by operator new
+  [[nodiscard]] static constexpr std::size_t SlotSize(
+      std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+    auto const index = ClassIndex(size, alignment);
+    return index == kClassCount ? 0 : detail::kSizeClasses[index].size;
+  }
+
+  // memory-pressure hook, see MemoryPool::Trim
+  std::size_t Trim() noexcept
+    requires TrimmableFreeList<FreeList<Slot<0>>, Slot<0>>
+  {
+    return [this]<std::size_t... I>(std::index_sequence<I...>) {
+      return (m_pools.template Get<I>().Trim() + ...);
+    }(std::make_index_sequence<kClassCount>{});
+  }
+
+ private:
+  [[nodiscard]] static constexpr std::size_t ClassIndex(
+      std::size_t size, std::size_t alignment) noexcept {
+    return detail::SizeClassIndex(size, alignment);
+  }
+
+  static constexpr auto kAllocate = []<std::size_t... I>(std::index_sequence<I...>) {
+    return std::array<void* (*)(Pools&), kClassCount>{
+        [](Pools& pools) -> void* { return pools.template Get<I>().Allocate(); }...};
+  }(std::make_index_sequence<kClassCount>{});
+
+  static constexpr auto kDeallocate = []<std::size_t... I>(std::index_sequence<I...>) {
+    return std::array<void (*)(Pools&, void*), kClassCount>{
+        [](Pools& pools, void* ptr) {
+          pools.template Get<I>().Free(static_cast<Slot<I>*>(ptr));
+        }...};
+  }(std::make_index_sequence<kClassCount>{});
+
+ private:
+  Pools m_pools;
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "AlignUtils.hpp"
+
+namespace detail {
+template <std::size_t Size, std::size_t Alignment>
+struct alignas(Alignment) SizeClassSlot {
+  // raw storage: no zeroing on MemoryPool::Allocate
+  SizeClassSlot() noexcept {
+  }
+
+  std::byte bytes[Size];
+};
+
+struct SizeClass {
+  std::size_t size;
+  std::size_t alignment;
+};
+
+// largest power of two dividing size, capped at a cache line
+constexpr std::size_t NaturalAlignment(std::size_t size) {
+  auto const alignment = size & (~size + 1);
+  return alignment < kCacheLineSize ? alignment : kCacheLineSize;
+}
+
+// 8 bytes apart up to 16, then ~4 classes per power of two, <= 25% waste
+inline constexpr std::array kSizeClasses = [] {
+  constexpr std::size_t kSizes[] = {8,   16,  32,  48,  64,  80,  96,  112,
+                                    128, 160, 192, 224, 256, 320, 384, 448,
+                                    512, 640, 768, 896, 1024};
+  std::array<SizeClass, std::size(kSizes)> classes{};
+  for (std::size_t i = 0; i < std::size(kSizes); ++i) {
+    classes[i] = {kSizes[i], NaturalAlignment(kSizes[i])};
+  }
+  return classes;
+}();
+inline constexpr std::size_t kSizeClassCount = kSizeClasses.size();
+inline constexpr std::size_t kMaxSizeClass = kSizeClasses.back().size;
+inline constexpr std::size_t kMaxSizeClassAlignment = kCacheLineSize;
+
+// smallest class holding size, indexed by size / kSizeClassGranularity
+inline constexpr std::size_t kSizeClassGranularity = 8;
+inline constexpr auto kSizeClassLookup = [] {
+  std::array<std::uint8_t, kMaxSizeClass / kSizeClassGranularity + 1> lookup{};
+  std::size_t index = 0;
+  for (std::size_t i = 0; i < lookup.size(); ++i) {
+    while (kSizeClasses[index].size < i * kSizeClassGranularity) {
+      ++index;
+    }
+    lookup[i] = static_cast<std::uint8_t>(index);
+  }
+  return lookup;
+}();
+
+// smallest class fitting both, kSizeClassCount when none does
+[[nodiscard]] constexpr std::size_t SizeClassIndex(std::size_t size,
+                                                   std::size_t alignment) noexcept {
+  if (alignment > kMaxSizeClassAlignment) {
+    return kSizeClassCount;
+  }
+  // every class is aligned to at least its size's alignment
+  size = size > alignment ? size : alignment;
+  if (size > kMaxSizeClass) {
+    return kSizeClassCount;
+  }
+
+  std::size_t index = kSizeClassLookup[(size + kSizeClassGranularity - 1) / kSizeClassGranularity];
+  while (index != kSizeClassCount && kSizeClasses[index].alignment < alignment) {
+    ++index;
+  }
+  return index;
+}
+}  // namespace detail
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+
+#include "AlignUtils.hpp"
+
+// Slot layout policies, a template argument of the free lists:
+//   kSize<T> / kAlignment<T> give the slot stride and alignment,
+//   Position<T>(index, count) is where the index-th fresh slot of a block of
+//   count slots sits. Recycled slots come back in LIFO order regardless.
+// MemoryPool takes the layout of its free list.
+
+// sizeof(T) rounded up to hold a link, what the pool always did
+struct PackedLayout {
+  template <typename T>
+  static constexpr std::size_t kSize = kSlotSize<T>;
+
+  template <typename T>
+  static constexpr std::size_t kAlignment = kSlotAlignment<T>;
+
+  template <typename T>
+  static constexpr std::size_t Position(std::size_t index, std::size_t) noexcept {
+    return index;
+  }
+};
+
+// one slot per cache line (or several lines for big T), no two slots ever
+// share a line; small T pay up to kCacheLineSize per slot
+struct PaddedLayout {
+  template <typename T>
+  static constexpr std::size_t kSize =
+      (kSlotSize<T> + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+
+  template <typename T>
+  static constexpr std::size_t kAlignment =
+      kSlotAlignment<T> > kCacheLineSize ? kSlotAlignment<T> : kCacheLineSize;
+
+  template <typename T>
+  static constexpr std::size_t Position(std::size_t index, std::size_t) noexcept {
+    return index;
+  }
+};
+
+// Packed memory, but consecutive fresh slots come from different lines:
+// the block is read as rows of kStride slots and handed out column by
+// column, so objects handed to different threads one after another don't
+// share a line until a column ends. kStride keeps neighbours a line plus a
+// slot apart, as the block is only slot aligned and a slot may straddle two
+// lines. Slots of a line or more keep packed order. Costs two divisions per
+// fresh slot.
+struct InterleavedLayout : PackedLayout {
+  template <typename T>
+  static constexpr std::size_t kStride = (kCacheLineSize - 1) / kSlotSize<T> + 2;
+
+  template <typename T>
+  static constexpr std::size_t Position(std::size_t index, std::size_t count) noexcept {
+    if constexpr (kSlotSize<T> >= kCacheLineSize) {
+      return index;
+    } else {
+      auto const rows = (count + kStride<T> - 1) / kStride<T>;
+      // columns that reach into the incomplete last row come first
+      auto const full = count - (rows - 1) * kStride<T>;
+      if (index < full * rows) {
+        return index % rows * kStride<T> + index / rows;
+      }
+      index -= full * rows;
+      return index % (rows - 1) * kStride<T> + full + index / (rows - 1);
+    }
+  }
+};
+
+// PackedLayout for free lists that don't say
+template <typename List>
+struct SlotLayoutOf {
+  using Type = PackedLayout;
+};
+
+template <typename List>
+  requires requires { typename List::Layout; }
+struct SlotLayoutOf<List> {
+  using Type = typename List::Layout;
+};
+
+// fresh slots of one block, in the order Layout hands them out
+template <typename T, typename Layout>
+class SlotSequence {
+  static constexpr auto kSize = Layout::template kSize<T>;
+  static constexpr auto kAlignment = Layout::template kAlignment<T>;
+
+ public:
+  SlotSequence() = default;
+
+  SlotSequence(std::byte* begin, std::size_t count) noexcept
+      : m_base(Align(begin, kAlignment)), m_count(count) {
+  }
+
+  // nullptr when every slot was handed out
+  [[nodiscard]] std::byte* Next() noexcept {
+    return m_next == m_count ? nullptr : At(m_next++);
+  }
+
+  [[nodiscard]] std::size_t Left() const noexcept {
+    return m_count - m_next;
+  }
+
+  // visits what Next would still return
+  template <typename Fn>
+  void ForEachLeft(Fn&& fn) const {
+    for (auto i = m_next; i < m_count; ++i) {
+      fn(At(i));
+    }
+  }
+
+ private:
+  [[nodiscard]] std::byte* At(std::size_t index) const noexcept {
+    return m_base + Layout::template Position<T>(index, m_count) * kSize;
+  }
+
+ private:
+  std::byte* m_base = nullptr;
+  std::size_t m_next = 0;
+  std::size_t m_count = 0;
+};
@@ -0,0 +1,191 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// {index, generation} packed into one word. Generation 0 is never issued,
+// so a value-initialized handle is always stale.
+template <typename Word, unsigned IndexBits>
+struct SlotHandle {
+  static_assert(std::is_unsigned_v<Word>);
+  static_assert(IndexBits > 0 && IndexBits < 8 * sizeof(Word));
+
+  using WordType = Word;
+  static constexpr unsigned kIndexBits = IndexBits;
+  static constexpr unsigned kGenerationBits = 8 * sizeof(Word) - IndexBits;
+  static constexpr Word kMaxIndex = (Word{1} << IndexBits) - 1;
+  static constexpr Word kMaxGeneration = static_cast<Word>(~Word{0} >> IndexBits);
+
+  Word value = 0;
+
+  [[nodiscard]] static constexpr SlotHandle Make(Word index, Word generation) noexcept {
+    return {static_cast<Word>(generation << IndexBits | index)};
+  }
+
+  [[nodiscard]] constexpr Word Index() const noexcept {
+    return value & kMaxIndex;
+  }
+
+  [[nodiscard]] constexpr Word Generation() const noexcept {
+    return value >> IndexBits;
+  }
+
+  friend constexpr bool operator==(SlotHandle, SlotHandle) noexcept = default;
+};
+
+// 1M live slots, a slot is recycled 4095 times before handles may alias
+using SlotHandle32 = SlotHandle<std::uint32_t, 20>;
+using SlotHandle64 = SlotHandle<std::uint64_t, 32>;
+
+// Slot map: values are packed in one contiguous array, erase moves the last
+// one into the hole. Handles go through a sparse slot table with the
+// generation and the dense position, so lookups are O(1) and catch
+// use-after-erase. Pointers and references are invalidated by Insert and
+// Erase, handles are not.
+// Allocator is rebound for the bookkeeping arrays, PoolAllocator fits.
+template <typename T, typename Handle = SlotHandle64, typename Allocator = std::allocator<T>>
+class SlotMap {
+  using Word = typename Handle::WordType;
+  static constexpr Word kNone = std::numeric_limits<Word>::max();
+
+  struct Slot {
+    Word generation = 1;
+    // dense position when live, next free slot otherwise
+    Word link = kNone;
+  };
+
+  template <typename U>
+  using Rebind = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+ public:
+  SlotMap() = default;
+
+  explicit SlotMap(Allocator const& allocator)
+      : m_values(allocator), m_owners(allocator), m_slots(allocator) {
+  }
+
+ public:
+  // throws std::length_error when the index bits run out
+  template <typename... U>
+  Handle Insert(U&&... args) {
+    if (m_freeHead == kNone) {
+      if (m_slots.size() > Handle::kMaxIndex) {
+        throw std::length_error("SlotMap: out of handle indices");
+      }
+      // a fresh slot on the free list stays harmless if anything below throws
+      m_slots.emplace_back();
+      m_freeHead = static_cast<Word>(m_slots.size() - 1);
+    }
+    auto const dense = static_cast<Word>(m_values.size());
+    m_values.emplace_back(std::forward<U>(args)...);
+    try {
+      m_owners.push_back(m_freeHead);
+    } catch (...) {
+      m_values.pop_back();
+      throw;
+    }
+
+    auto const index = m_freeHead;
+    m_freeHead = m_slots[index].link;
+    m_slots[index].link = dense;
+    return Handle::Make(index, m_slots[index].generation);
+  }
+
+  // false for stale handles
+  bool Erase(Handle handle) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    auto const dense = Find(handle);
+    if (dense == kNone) {
+      return false;
+    }
+    auto const last = static_cast<Word>(m_values.size() - 1);
+    if (dense != last) {
+      m_values[dense] = std::move(m_values[last]);
+      m_owners[dense] = m_owners[last];
+      m_slots[m_owners[dense]].link = dense;
+    }
+    m_values.pop_back();
+    m_owners.pop_back();
+
+    auto& slot = m_slots[handle.Index()];
+    slot.generation = slot.generation == Handle::kMaxGeneration ? 1 : slot.generation + 1;
+    slot.link = m_freeHead;
+    m_freeHead = handle.Index();
+    return true;
+  }
+
+  [[nodiscard]] T* Get(Handle handle) noexcept {
+    auto const dense = Find(handle);
+    return dense == kNone ? nullptr : &m_values[dense];
+  }
+
+  [[nodiscard]] T const* Get(Handle handle) const noexcept {
+    auto const dense = Find(handle);
+    return dense == kNone ? nullptr : &m_values[dense];
+  }
+
+  [[nodiscard]] bool Contains(Handle handle) const noexcept {
+    return Find(handle) != kNone;
+  }
+
+  // live values in dense order, for linear scans
+  [[nodiscard]] std::span<T> Values() noexcept {
+    return m_values;
+  }
+
+  [[nodiscard]] std::span<T const> Values() const noexcept {
+    return m_values;
+  }
+
+  // handle of Values()[position]
+  [[nodiscard]] Handle HandleAt(std::size_t position) const noexcept {
+    auto const index = m_owners[position];
+    return Handle::Make(index, m_slots[index].generation);
+  }
+
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return m_values.size();
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return m_values.empty();
+  }
+
+  void Reserve(std::size_t count) {
+    m_values.reserve(count);
+    m_owners.reserve(count);
+    m_slots.reserve(count);
+  }
+
+  // every outstanding handle goes stale
+  void Clear() noexcept {
+    while (!m_values.empty()) {
+      Erase(HandleAt(m_values.size() - 1));
+    }
+  }
+
+ private:
+  [[nodiscard]] Word Find(Handle handle) const noexcept {
+    auto const index = handle.Index();
+    if (index >= m_slots.size()) {
+      return kNone;
+    }
+    auto const& slot = m_slots[index];
+    // a free slot is a generation ahead of every handle issued for it
+    return slot.generation == handle.Generation() && slot.link < m_values.size()
+               ? slot.link
+               : kNone;
+  }
+
+ private:
+  std::vector<T, Allocator> m_values;
+  // slot index of each dense value
+  std::vector<Word, Rebind<Word>> m_owners;
+  std::vector<Slot, Rebind<Slot>> m_slots;
+  Word m_freeHead = kNone;
+};
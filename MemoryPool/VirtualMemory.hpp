@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+
+// clang-format off
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// clang-format on
+
+// Page level memory straight from the OS, bypassing operator new.
+// All functions return nullptr/false on failure and never throw.
+namespace vm {
+inline std::size_t PageSize() noexcept {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwPageSize;
+#else
+  static auto const kPageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return kPageSize;
+#endif
+}
+
+// address space only, pages must be committed before use
+inline void* Reserve(std::size_t bytes) noexcept {
+#ifdef _WIN32
+  return VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+#else
+  // overcommitted, pages are backed on first touch
+  auto ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+inline bool Commit([[maybe_unused]] void* ptr,
+                   [[maybe_unused]] std::size_t bytes) noexcept {
+#ifdef _WIN32
+  return VirtualAlloc(ptr, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+  return true;
+#endif
+}
+
+// reserved and committed
+inline void* Map(std::size_t bytes) noexcept {
+#ifdef _WIN32
+  return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+  auto ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+// whole mappings only, as returned by Reserve or Map
+inline void Release(void* ptr, [[maybe_unused]] std::size_t bytes) noexcept {
+#ifdef _WIN32
+  VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+  munmap(ptr, bytes);
+#endif
+}
+}  // namespace vm
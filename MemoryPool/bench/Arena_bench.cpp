@@ -0,0 +1,63 @@
+#include <array>
+#include <memory_resource>
+#include <vector>
+
+#include "../Arena.hpp"
+#include "../MemoryPool.hpp"
+#include <benchmark/benchmark.h>
+
+// A request allocates state.range(0) small objects that all die at its end.
+
+namespace {
+struct Node {
+  std::array<std::byte, 48> bytes;
+};
+
+void BM_RequestPoolFree(benchmark::State& state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+  MemoryPool<Node> pool(count);
+  std::vector<Node*> nodes(count);
+  for (auto _ : state) {
+    for (auto& node : nodes) {
+      node = pool.Allocate();
+    }
+    benchmark::DoNotOptimize(nodes.data());
+    for (auto node : nodes) {
+      pool.Free(node);
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+
+void BM_RequestArenaReset(benchmark::State& state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+  Arena<> arena(count * sizeof(Node));
+  std::vector<Node*> nodes(count);
+  for (auto _ : state) {
+    for (auto& node : nodes) {
+      node = arena.Create<Node>();
+    }
+    benchmark::DoNotOptimize(nodes.data());
+    arena.Reset();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+
+void BM_RequestMonotonicRelease(benchmark::State& state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+  std::pmr::monotonic_buffer_resource resource(count * sizeof(Node));
+  std::vector<Node*> nodes(count);
+  for (auto _ : state) {
+    for (auto& node : nodes) {
+      node = new (resource.allocate(sizeof(Node), alignof(Node))) Node();
+    }
+    benchmark::DoNotOptimize(nodes.data());
+    resource.release();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+}  // namespace
+
+BENCHMARK(BM_RequestPoolFree)->RangeMultiplier(16)->Range(64, 1 << 14);
+BENCHMARK(BM_RequestArenaReset)->RangeMultiplier(16)->Range(64, 1 << 14);
+BENCHMARK(BM_RequestMonotonicRelease)->RangeMultiplier(16)->Range(64, 1 << 14);
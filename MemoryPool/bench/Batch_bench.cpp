@@ -0,0 +1,56 @@
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../ConcurrentFreeList.hpp"
+#include "../FreeList.hpp"
+#include "../LazyFreeList.hpp"
+#include "../MemoryPool.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+struct Packet {
+  std::array<std::uint64_t, 4> header;
+};
+
+constexpr std::size_t kPoolSize = 1 << 12;
+
+// a burst of range(0) objects allocated and freed one by one
+template <typename FreeList>
+void BM_ScalarBurst(benchmark::State& state) {
+  auto const burst = static_cast<std::size_t>(state.range(0));
+  MemoryPool<Packet, FreeList> pool(kPoolSize);
+  std::vector<Packet*> ptrs(burst);
+  for (auto _ : state) {
+    for (auto& ptr : ptrs) {
+      ptr = pool.Allocate();
+    }
+    benchmark::DoNotOptimize(ptrs.data());
+    for (auto ptr : ptrs) {
+      pool.Free(ptr);
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * burst));
+}
+
+// the same burst through AllocateBatch/FreeBatch
+template <typename FreeList>
+void BM_BatchBurst(benchmark::State& state) {
+  auto const burst = static_cast<std::size_t>(state.range(0));
+  MemoryPool<Packet, FreeList> pool(kPoolSize);
+  std::vector<Packet*> ptrs(burst);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pool.AllocateBatch(ptrs));
+    benchmark::DoNotOptimize(ptrs.data());
+    pool.FreeBatch(ptrs);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * burst));
+}
+}  // namespace
+
+BENCHMARK(BM_ScalarBurst<FreeList<Packet>>)->RangeMultiplier(2)->Range(32, 256);
+BENCHMARK(BM_BatchBurst<FreeList<Packet>>)->RangeMultiplier(2)->Range(32, 256);
+BENCHMARK(BM_ScalarBurst<LazyFreeList<Packet>>)->RangeMultiplier(2)->Range(32, 256);
+BENCHMARK(BM_BatchBurst<LazyFreeList<Packet>>)->RangeMultiplier(2)->Range(32, 256);
+BENCHMARK(BM_ScalarBurst<ConcurrentFreeList<Packet>>)->RangeMultiplier(2)->Range(32, 256);
+BENCHMARK(BM_BatchBurst<ConcurrentFreeList<Packet>>)->RangeMultiplier(2)->Range(32, 256);
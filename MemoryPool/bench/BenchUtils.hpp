@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+// resident set size of the process, 0 where unknown
+inline std::size_t ResidentBytes() {
+#ifdef __linux__
+  std::ifstream statm{"/proc/self/statm"};
+  std::size_t total = 0;
+  std::size_t resident = 0;
+  if (statm >> total >> resident) {
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include <array>
+#include <cstdint>
+
+#include "../FreeList.hpp"
+#include "../LazyFreeList.hpp"
+#include "../MemoryPool.hpp"
+#include "BenchUtils.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+struct Object {
+  std::array<std::uint64_t, 4> payload;
+};
+
+// eager threading writes every slot, lazy threading none of them
+template <typename FreeList>
+void BM_PoolConstruction(benchmark::State& state) {
+  auto const size = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    MemoryPool<Object, FreeList> pool(size);
+    benchmark::DoNotOptimize(&pool);
+  }
+
+  auto const before = ResidentBytes();
+  MemoryPool<Object, FreeList> pool(size);
+  benchmark::DoNotOptimize(&pool);
+  state.counters["rss_bytes"] = static_cast<double>(ResidentBytes() - before);
+  state.counters["pool_bytes"] = static_cast<double>(size * sizeof(Object));
+}
+
+// construction plus the first 1% of allocations
+template <typename FreeList>
+void BM_PoolConstructionAndFirstUse(benchmark::State& state) {
+  auto const size = static_cast<std::size_t>(state.range(0));
+  auto const used = size / 100;
+  for (auto _ : state) {
+    MemoryPool<Object, FreeList> pool(size);
+    for (std::size_t i = 0; i < used; ++i) {
+      benchmark::DoNotOptimize(pool.Allocate());
+    }
+  }
+
+  auto const before = ResidentBytes();
+  MemoryPool<Object, FreeList> pool(size);
+  for (std::size_t i = 0; i < used; ++i) {
+    benchmark::DoNotOptimize(pool.Allocate());
+  }
+  state.counters["rss_bytes"] = static_cast<double>(ResidentBytes() - before);
+}
+}  // namespace
+
+BENCHMARK(BM_PoolConstruction<FreeList<Object>>)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PoolConstruction<LazyFreeList<Object>>)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PoolConstructionAndFirstUse<FreeList<Object>>)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PoolConstructionAndFirstUse<LazyFreeList<Object>>)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
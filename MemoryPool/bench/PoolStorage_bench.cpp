@@ -0,0 +1,62 @@
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../MemoryPool.hpp"
+#include "../PoolStorage.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+struct Object {
+  std::array<std::uint64_t, 8> payload;
+};
+
+constexpr std::size_t kSlots = (256 << 20) / sizeof(Object);
+
+// random reads over a large pool: dominated by TLB misses on 4K pages
+template <typename Pool>
+void RandomAccess(benchmark::State& state, Pool& pool) {
+  std::vector<Object*> objects(kSlots);
+  for (std::size_t i = 0; i < kSlots; ++i) {
+    objects[i] = pool.Allocate();
+    objects[i]->payload[0] = i;
+  }
+  std::ranges::shuffle(objects, std::mt19937_64{42});
+
+  std::uint64_t sum = 0;
+  std::size_t next = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < 1024; ++i) {
+      sum += objects[next]->payload[0];
+      next = next + 1 == kSlots ? 0 : next + 1;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * 1024);
+
+  for (auto ptr : objects) {
+    pool.Free(ptr);
+  }
+}
+
+void BM_RandomAccessHeap(benchmark::State& state) {
+  MemoryPool<Object> pool(kSlots);
+  RandomAccess(state, pool);
+}
+
+void BM_RandomAccessPages(benchmark::State& state, PageStorage::Options options) {
+  MemoryPool<Object, LazyFreeList<Object>, NoStats, PageStorage> pool(
+      kSlots, GrowthPolicy::Fixed(), PageStorage{options});
+  RandomAccess(state, pool);
+}
+}  // namespace
+
+BENCHMARK(BM_RandomAccessHeap);
+BENCHMARK_CAPTURE(BM_RandomAccessPages, pages_4k,
+                  PageStorage::Options{.hugePages = PageStorage::HugePages::none});
+BENCHMARK_CAPTURE(BM_RandomAccessPages, transparent_huge,
+                  PageStorage::Options{.hugePages = PageStorage::HugePages::transparent});
+BENCHMARK_CAPTURE(BM_RandomAccessPages, reserved_huge_prefault,
+                  PageStorage::Options{.hugePages = PageStorage::HugePages::reserved,
+                                       .prefault = true});
@@ -0,0 +1,57 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentFreeList.hpp"
+#include "../MemoryPool.hpp"
+#include "../SlotLayout.hpp"
+#include <benchmark/benchmark.h>
+
+// False sharing between pool slots: one thread allocates a counter per
+// worker back to back, then every worker hammers its own counter. Packed
+// counters share a line and ping-pong between cores, padded ones can't,
+// interleaved ones sit a line apart in packed memory.
+// Needs as many cores as workers to show anything.
+
+namespace {
+struct Counter {
+  std::atomic<std::uint64_t> value{0};
+};
+
+constexpr std::uint64_t kIncrements = 1 << 20;
+
+template <typename Layout>
+void BM_FalseSharing(benchmark::State& state) {
+  auto const workers = static_cast<std::size_t>(state.range(0));
+  MemoryPool<Counter, ConcurrentFreeList<Counter, Layout>> pool(256);
+
+  for (auto _ : state) {
+    std::vector<Counter*> counters;
+    for (std::size_t i = 0; i < workers; ++i) {
+      counters.push_back(pool.Allocate());
+    }
+
+    std::vector<std::thread> threads;
+    for (auto counter : counters) {
+      threads.emplace_back([counter] {
+        for (std::uint64_t i = 0; i < kIncrements; ++i) {
+          counter->value.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (auto counter : counters) {
+      pool.Free(counter);
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * workers * kIncrements));
+}
+}  // namespace
+
+BENCHMARK(BM_FalseSharing<PackedLayout>)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK(BM_FalseSharing<PaddedLayout>)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK(BM_FalseSharing<InterleavedLayout>)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
@@ -0,0 +1,155 @@
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "../PoolAllocator.hpp"
+#include "../PoolResource.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+constexpr int kKeySpace = 1 << 20;
+
+std::vector<int> RandomKeys(std::size_t count) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> keys{0, kKeySpace};
+  std::vector<int> result(count);
+  for (auto& key : result) {
+    key = keys(gen);
+  }
+  return result;
+}
+
+// steady state: state.range(0) live entries, each iteration erases one
+// key and inserts another
+template <typename Map>
+void Churn(benchmark::State& state, Map& map) {
+  auto const size = static_cast<std::size_t>(state.range(0));
+  auto const keys = RandomKeys(size * 2);
+  for (std::size_t i = 0; i < size; ++i) {
+    map.emplace(keys[i], keys[i]);
+  }
+
+  std::size_t erase = 0;
+  std::size_t insert = size;
+  for (auto _ : state) {
+    map.erase(keys[erase]);
+    map.emplace(keys[insert], keys[insert]);
+    erase = erase + 1 == keys.size() ? 0 : erase + 1;
+    insert = insert + 1 == keys.size() ? 0 : insert + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename List>
+void ListChurn(benchmark::State& state, List& list) {
+  auto const size = static_cast<std::size_t>(state.range(0));
+  for (std::size_t i = 0; i < size; ++i) {
+    list.push_back(static_cast<int>(i));
+  }
+  for (auto _ : state) {
+    list.pop_front();
+    list.push_back(0);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T>
+using Alloc = PoolAllocator<T>;
+using Pair = std::pair<int const, int>;
+
+void BM_MapDefault(benchmark::State& state) {
+  std::map<int, int> map;
+  Churn(state, map);
+}
+
+void BM_MapPoolAllocator(benchmark::State& state) {
+  SizeClassAllocator<> backing;
+  std::map<int, int, std::less<>, Alloc<Pair>> map{Alloc<Pair>{backing}};
+  Churn(state, map);
+}
+
+void BM_MapPmrPoolResource(benchmark::State& state) {
+  PoolResource<> resource;
+  std::pmr::map<int, int> map{&resource};
+  Churn(state, map);
+}
+
+void BM_MapPmrUnsynchronizedPool(benchmark::State& state) {
+  std::pmr::unsynchronized_pool_resource resource;
+  std::pmr::map<int, int> map{&resource};
+  Churn(state, map);
+}
+
+void BM_UnorderedMapDefault(benchmark::State& state) {
+  std::unordered_map<int, int> map;
+  Churn(state, map);
+}
+
+void BM_UnorderedMapPoolAllocator(benchmark::State& state) {
+  SizeClassAllocator<> backing;
+  std::unordered_map<int, int, std::hash<int>, std::equal_to<>, Alloc<Pair>>
+      map{Alloc<Pair>{backing}};
+  Churn(state, map);
+}
+
+void BM_UnorderedMapPmrPoolResource(benchmark::State& state) {
+  PoolResource<> resource;
+  std::pmr::unordered_map<int, int> map{&resource};
+  Churn(state, map);
+}
+
+void BM_ListDefault(benchmark::State& state) {
+  std::list<int> list;
+  ListChurn(state, list);
+}
+
+void BM_ListPoolAllocator(benchmark::State& state) {
+  SizeClassAllocator<> backing;
+  std::list<int, Alloc<int>> list{Alloc<int>{backing}};
+  ListChurn(state, list);
+}
+
+void BM_ListPmrPoolResource(benchmark::State& state) {
+  PoolResource<> resource;
+  std::pmr::list<int> list{&resource};
+  ListChurn(state, list);
+}
+
+// growth of a pmr::vector, the buffers move between size classes
+void BM_PmrVectorPushBack(benchmark::State& state, std::pmr::memory_resource* resource) {
+  auto const size = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    std::pmr::vector<int> vec{resource};
+    for (std::size_t i = 0; i < size; ++i) {
+      vec.push_back(static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(vec.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size));
+}
+
+void BM_PmrVectorDefault(benchmark::State& state) {
+  BM_PmrVectorPushBack(state, std::pmr::new_delete_resource());
+}
+
+void BM_PmrVectorPoolResource(benchmark::State& state) {
+  PoolResource<> resource;
+  BM_PmrVectorPushBack(state, &resource);
+}
+}  // namespace
+
+BENCHMARK(BM_MapDefault)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_MapPoolAllocator)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_MapPmrPoolResource)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_MapPmrUnsynchronizedPool)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_UnorderedMapDefault)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_UnorderedMapPoolAllocator)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_UnorderedMapPmrPoolResource)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_ListDefault)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_ListPoolAllocator)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_ListPmrPoolResource)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_PmrVectorDefault)->Range(1 << 4, 1 << 8);
+BENCHMARK(BM_PmrVectorPoolResource)->Range(1 << 4, 1 << 8);
@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentFreeList.hpp"
+#include "../FreeList.hpp"
+#include "../LazyFreeList.hpp"
+#include "../MemoryPool.hpp"
+#include "../RemoteFreeList.hpp"
+#include "../SizeClassAllocator.hpp"
+#include <benchmark/benchmark.h>
+
+// Allocate/free throughput of MemoryPool against the usual alternatives.
+// Each strategy is an object with Allocate() / Free(T*) / EndRound().
+// Diff two commits with benchmark's tools/compare.py over the JSON that
+// the MemoryPool_bench_json target writes.
+
+namespace {
+template <std::size_t Size>
+struct Object {
+  std::array<std::byte, Size> bytes;
+};
+
+constexpr std::size_t kInitialSlots = 1024;
+
+template <typename T, template <typename> typename FreeList>
+class PoolStrategy {
+ public:
+  T* Allocate() {
+    return m_pool.Allocate();
+  }
+
+  void Free(T* ptr) {
+    m_pool.Free(ptr);
+  }
+
+  void EndRound() {
+  }
+
+ private:
+  MemoryPool<T, FreeList<T>> m_pool{kInitialSlots, GrowthPolicy{}};
+};
+
+template <typename T>
+class SizeClassStrategy {
+ public:
+  T* Allocate() {
+    return new (m_allocator.Allocate(sizeof(T), alignof(T))) T();
+  }
+
+  void Free(T* ptr) {
+    m_allocator.Deallocate(ptr, sizeof(T), alignof(T));
+  }
+
+  void EndRound() {
+  }
+
+ private:
+  SizeClassAllocator<> m_allocator;
+};
+
+template <typename T>
+struct NewDeleteStrategy {
+  T* Allocate() {
+    return new T();
+  }
+
+  void Free(T* ptr) {
+    delete ptr;
+  }
+
+  void EndRound() {
+  }
+};
+
+template <typename T, typename Resource>
+class PmrStrategy {
+ public:
+  T* Allocate() {
+    return new (m_resource.allocate(sizeof(T), alignof(T))) T();
+  }
+
+  void Free(T* ptr) {
+    m_resource.deallocate(ptr, sizeof(T), alignof(T));
+  }
+
+  // monotonic_buffer_resource only gives memory back here
+  void EndRound() {
+    if constexpr (std::is_same_v<Resource, std::pmr::monotonic_buffer_resource>) {
+      m_resource.release();
+    }
+  }
+
+ private:
+  Resource m_resource;
+};
+
+enum class Order { lifo, fifo, random };
+
+// indices into the allocation sequence, in the order they are freed
+std::vector<std::size_t> FreeOrder(std::size_t count, Order order) {
+  std::vector<std::size_t> indices(count);
+  std::iota(indices.begin(), indices.end(), 0);
+  if (order == Order::lifo) {
+    std::ranges::reverse(indices);
+  } else if (order == Order::random) {
+    std::ranges::shuffle(indices, std::mt19937{42});
+  }
+  return indices;
+}
+
+// a round allocates state.range(0) objects and frees them in Order
+template <typename Strategy, typename T, Order Kind>
+void BM_Round(benchmark::State& state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto const order = FreeOrder(count, Kind);
+  std::vector<T*> ptrs(count);
+  Strategy strategy;
+
+  for (auto _ : state) {
+    for (auto& ptr : ptrs) {
+      ptr = strategy.Allocate();
+    }
+    benchmark::DoNotOptimize(ptrs.data());
+    for (auto index : order) {
+      strategy.Free(ptrs[index]);
+    }
+    strategy.EndRound();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+  state.SetLabel(std::to_string(sizeof(T)) + "B");
+}
+
+// Single-producer single-consumer ring of pointers: one thread allocates,
+// the other one frees, the remote-free pattern of pipelines.
+template <typename T>
+class Ring {
+  static constexpr std::size_t kCapacity = 1024;
+
+ public:
+  bool Push(T* ptr) noexcept {
+    auto const tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == kCapacity) {
+      return false;
+    }
+    m_slots[tail % kCapacity] = ptr;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  T* Pop() noexcept {
+    auto const head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    auto ptr = m_slots[head % kCapacity];
+    m_head.store(head + 1, std::memory_order_release);
+    return ptr;
+  }
+
+ private:
+  std::array<T*, kCapacity> m_slots{};
+  alignas(kCacheLineSize) std::atomic<std::size_t> m_head{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> m_tail{0};
+};
+
+template <typename Strategy, typename T>
+void BM_ProducerConsumer(benchmark::State& state) {
+  Strategy strategy;
+  Ring<T> ring;
+  std::atomic<bool> done{false};
+
+  std::thread consumer([&] {
+    for (;;) {
+      if (auto ptr = ring.Pop()) {
+        strategy.Free(ptr);
+      } else if (done.load(std::memory_order_acquire)) {
+        // the producer stopped before reading done, drain what is left
+        while (auto rest = ring.Pop()) {
+          strategy.Free(rest);
+        }
+        return;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  for (auto _ : state) {
+    auto ptr = strategy.Allocate();
+    while (!ring.Push(ptr)) {
+      std::this_thread::yield();
+    }
+  }
+  done.store(true, std::memory_order_release);
+  consumer.join();
+  state.SetItemsProcessed(state.iterations());
+}
+
+// A plain pool behind a mutex, what workers shared before
+// ConcurrentFreeList.
+template <typename T>
+class MutexPool {
+ public:
+  explicit MutexPool(std::size_t size)
+      : m_pool(size) {
+  }
+
+  T* Allocate() {
+    std::lock_guard lock{m_mutex};
+    return m_pool.Allocate();
+  }
+
+  void Free(T* ptr) {
+    std::lock_guard lock{m_mutex};
+    m_pool.Free(ptr);
+  }
+
+ private:
+  std::mutex m_mutex;
+  MemoryPool<T> m_pool;
+};
+
+template <typename T>
+using SharedConcurrentPool = MemoryPool<T, ConcurrentFreeList<T>>;
+
+constexpr std::size_t kContendedBatch = 64;
+constexpr int kMaxContendedThreads = 8;
+
+// Every benchmark thread allocates kContendedBatch objects from one shared
+// pool and frees them again; compare items/s across thread counts.
+template <typename Pool, typename T>
+void BM_Contended(benchmark::State& state) {
+  static std::unique_ptr<Pool> pool;
+  if (state.thread_index() == 0) {
+    // room for every thread's batch and magazine
+    pool = std::make_unique<Pool>(kMaxContendedThreads *
+                                  (kContendedBatch + ConcurrentFreeList<T>::kMagazineSize));
+  }
+  std::array<T*, kContendedBatch> live{};
+  for (auto _ : state) {
+    for (auto& ptr : live) {
+      ptr = pool->Allocate();
+      if (ptr == nullptr) {
+        state.SkipWithError("pool ran dry");
+        return;
+      }
+    }
+    benchmark::DoNotOptimize(live.data());
+    for (auto ptr : live) {
+      pool->Free(ptr);
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kContendedBatch));
+}
+
+template <typename T>
+using LazyPool = PoolStrategy<T, LazyFreeList>;
+template <typename T>
+using EagerPool = PoolStrategy<T, FreeList>;
+template <typename T>
+using ConcurrentPool = PoolStrategy<T, ConcurrentFreeList>;
+template <typename T>
+using RemotePool = PoolStrategy<T, RemoteFreeList>;
+template <typename T>
+using UnsyncPmr = PmrStrategy<T, std::pmr::unsynchronized_pool_resource>;
+template <typename T>
+using SyncPmr = PmrStrategy<T, std::pmr::synchronized_pool_resource>;
+template <typename T>
+using MonotonicPmr = PmrStrategy<T, std::pmr::monotonic_buffer_resource>;
+}  // namespace
+
+#define POOL_BENCH_ROUND(Strategy, Size, Kind)                           \
+  BENCHMARK(BM_Round<Strategy<Object<Size>>, Object<Size>, Order::Kind>) \
+      ->RangeMultiplier(16)                                              \
+      ->Range(256, 1 << 16)
+
+#define POOL_BENCH_STRATEGIES(Size, Kind)          \
+  POOL_BENCH_ROUND(LazyPool, Size, Kind);          \
+  POOL_BENCH_ROUND(EagerPool, Size, Kind);         \
+  POOL_BENCH_ROUND(SizeClassStrategy, Size, Kind); \
+  POOL_BENCH_ROUND(NewDeleteStrategy, Size, Kind); \
+  POOL_BENCH_ROUND(UnsyncPmr, Size, Kind);         \
+  POOL_BENCH_ROUND(MonotonicPmr, Size, Kind)
+
+POOL_BENCH_STRATEGIES(16, lifo);
+POOL_BENCH_STRATEGIES(16, fifo);
+POOL_BENCH_STRATEGIES(16, random);
+POOL_BENCH_STRATEGIES(64, lifo);
+POOL_BENCH_STRATEGIES(64, fifo);
+POOL_BENCH_STRATEGIES(64, random);
+POOL_BENCH_STRATEGIES(256, lifo);
+POOL_BENCH_STRATEGIES(256, fifo);
+POOL_BENCH_STRATEGIES(256, random);
+
+BENCHMARK(BM_ProducerConsumer<ConcurrentPool<Object<64>>, Object<64>>)->UseRealTime();
+BENCHMARK(BM_ProducerConsumer<RemotePool<Object<64>>, Object<64>>)->UseRealTime();
+BENCHMARK(BM_ProducerConsumer<NewDeleteStrategy<Object<64>>, Object<64>>)->UseRealTime();
+BENCHMARK(BM_ProducerConsumer<SyncPmr<Object<64>>, Object<64>>)->UseRealTime();
+
+BENCHMARK(BM_Contended<MutexPool<Object<64>>, Object<64>>)
+    ->ThreadRange(1, kMaxContendedThreads)
+    ->UseRealTime();
+BENCHMARK(BM_Contended<SharedConcurrentPool<Object<64>>, Object<64>>)
+    ->ThreadRange(1, kMaxContendedThreads)
+    ->UseRealTime();
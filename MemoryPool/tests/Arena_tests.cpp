@@ -0,0 +1,159 @@
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../Arena.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+struct Tracked {
+  explicit Tracked(std::vector<int>& log, int id, bool fail = false)
+      : log(log), id(id) {
+    if (fail) {
+      throw std::runtime_error("ctor");
+    }
+  }
+
+  ~Tracked() {
+    log.push_back(id);
+  }
+
+  std::vector<int>& log;
+  int id;
+};
+
+struct alignas(64) Wide {
+  std::byte bytes[64];
+};
+}  // namespace
+
+TEST(ArenaTest, BumpsWithAlignment) {
+  Arena<> arena(1024, GrowthPolicy::Fixed());
+  auto const a = static_cast<std::byte*>(arena.Allocate(1, 1));
+  auto const b = static_cast<std::byte*>(arena.Allocate(8, 8));
+  auto const wide = arena.Create<Wide>();
+
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b) % 8, 0);
+  ASSERT_EQ(b - a, 8);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(wide) % 64, 0);
+  ASSERT_EQ(arena.BlockCount(), 1);
+}
+
+TEST(ArenaTest, FixedArenaRunsOut) {
+  Arena<> arena(256, GrowthPolicy::Fixed());
+  ASSERT_NE(arena.Allocate(200, 8), nullptr);
+  ASSERT_EQ(arena.Allocate(100, 8), nullptr);
+  ASSERT_NE(arena.Allocate(56, 8), nullptr);
+  ASSERT_EQ(arena.Used(), 256);
+}
+
+TEST(ArenaTest, ChainsBlocksAndReusesThemAfterReset) {
+  Arena<> arena(256, GrowthPolicy{});
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_NE(arena.Allocate(64, 8), nullptr);
+  }
+  auto const blocks = arena.BlockCount();
+  auto const capacity = arena.Capacity();
+  ASSERT_GT(blocks, 1);
+  ASSERT_GE(capacity, 6400);
+
+  arena.Reset();
+  ASSERT_EQ(arena.Used(), 0);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_NE(arena.Allocate(64, 8), nullptr);
+  }
+  ASSERT_EQ(arena.BlockCount(), blocks);
+
+  arena.Release();
+  ASSERT_EQ(arena.BlockCount(), 1);
+  ASSERT_EQ(arena.Capacity(), 256);
+}
+
+TEST(ArenaTest, OversizedRequestGetsItsOwnBlock) {
+  Arena<> arena(256, GrowthPolicy{});
+  auto const big = arena.Allocate(1 << 20, 4096);
+  ASSERT_NE(big, nullptr);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(big) % 4096, 0);
+  ASSERT_EQ(arena.BlockCount(), 2);
+}
+
+TEST(ArenaTest, MaxCapacityIsRespected) {
+  Arena<> arena(256, GrowthPolicy{.maxCapacity = 1024});
+  ASSERT_EQ(arena.Allocate(2048, 8), nullptr);
+  ASSERT_NE(arena.Allocate(512, 8), nullptr);
+  ASSERT_LE(arena.Capacity(), 1024);
+}
+
+TEST(ArenaTest, RewindRunsDestructorsNewestFirst) {
+  std::vector<int> log;
+  Arena<> arena(1024, GrowthPolicy{});
+  ASSERT_NE(arena.Create<Tracked>(log, 1), nullptr);
+  auto const marker = arena.Mark();
+  ASSERT_NE(arena.Create<Tracked>(log, 2), nullptr);
+  ASSERT_NE(arena.Create<Tracked>(log, 3), nullptr);
+  // trivially destructible, no registry entry
+  ASSERT_EQ(*arena.Create<int>(4), 4);
+
+  arena.Rewind(marker);
+  ASSERT_EQ(log, (std::vector<int>{3, 2}));
+  arena.Reset();
+  ASSERT_EQ(log, (std::vector<int>{3, 2, 1}));
+}
+
+TEST(ArenaTest, ThrowingConstructorIsNotFinalized) {
+  std::vector<int> log;
+  {
+    Arena<> arena;
+    ASSERT_NE(arena.Create<Tracked>(log, 1), nullptr);
+    ASSERT_THROW(static_cast<void>(arena.Create<Tracked>(log, 2, true)), std::runtime_error);
+  }
+  ASSERT_EQ(log, std::vector<int>{1});
+}
+
+TEST(ArenaTest, RewindAcrossBlocks) {
+  Arena<> arena(128, GrowthPolicy{});
+  ASSERT_NE(arena.Allocate(64, 8), nullptr);
+  auto const marker = arena.Mark();
+  auto const used = arena.Used();
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_NE(arena.Allocate(64, 8), nullptr);
+  }
+  arena.Rewind(marker);
+  ASSERT_EQ(arena.Used(), used);
+  auto const first = static_cast<std::byte*>(arena.Allocate(64, 8));
+  ASSERT_EQ(static_cast<std::byte*>(arena.Allocate(0, 1)), first + 64);
+}
+
+TEST(ArenaTest, CallerBuffer) {
+  alignas(std::max_align_t) std::array<std::byte, 512> buffer;
+  Arena<> arena(buffer);
+  auto const ptr = static_cast<std::byte*>(arena.Allocate(100, 8));
+  ASSERT_GE(ptr, buffer.data());
+  ASSERT_LT(ptr, buffer.data() + buffer.size());
+  ASSERT_EQ(arena.Allocate(1024, 8), nullptr);
+}
+
+TEST(ArenaResourceTest, PmrContainers) {
+  ArenaResource<> resource(1024);
+  {
+    std::pmr::vector<std::pmr::string> strings{&resource};
+    for (int i = 0; i < 100; ++i) {
+      strings.emplace_back(std::to_string(i) + " long enough to skip the small string buffer");
+    }
+    ASSERT_EQ(strings[42].substr(0, 3), "42 ");
+    ASSERT_GT(resource.GetArena().BlockCount(), 1);
+  }
+  resource.GetArena().Reset();
+  ASSERT_EQ(resource.GetArena().Used(), 0);
+  ASSERT_TRUE(resource.is_equal(resource));
+}
+
+TEST(ArenaResourceTest, ThrowsWhenExhausted) {
+  alignas(std::max_align_t) std::array<std::byte, 256> buffer;
+  ArenaResource<> resource(buffer);
+  std::pmr::vector<int> vec{&resource};
+  ASSERT_THROW(vec.resize(1000), std::bad_alloc);
+}
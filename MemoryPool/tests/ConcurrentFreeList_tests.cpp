@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentFreeList.hpp"
+#include "../MemoryPool.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+struct alignas(alignof(uintptr_t)) TestNode {
+  int value;
+};
+
+struct Payload {
+  std::uint64_t owner;
+  std::uint64_t check;
+};
+
+using ConcurrentPool = MemoryPool<Payload, ConcurrentFreeList<Payload>>;
+
+// what our workers do today
+class MutexPool {
+ public:
+  explicit MutexPool(std::size_t size)
+      : m_pool(size) {
+  }
+
+  Payload* Allocate(std::uint64_t owner, std::uint64_t check) {
+    std::lock_guard lock{m_mutex};
+    return m_pool.Allocate(owner, check);
+  }
+
+  void Free(Payload* ptr) {
+    std::lock_guard lock{m_mutex};
+    m_pool.Free(ptr);
+  }
+
+ private:
+  std::mutex m_mutex;
+  MemoryPool<Payload> m_pool;
+};
+
+constexpr std::size_t kThreads = 8;
+constexpr std::size_t kPerThread = 256;
+constexpr std::size_t kRounds = 2000;
+
+// every thread keeps kPerThread objects alive, frees and reallocates them
+template <typename Pool>
+void Hammer(Pool& pool, std::atomic<bool>& corrupted) {
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      std::vector<Payload*> live(kPerThread, nullptr);
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      for (std::size_t round = 0; round < kRounds; ++round) {
+        for (std::size_t i = 0; i < kPerThread; ++i) {
+          live[i] = pool.Allocate(t, round * kPerThread + i);
+          if (live[i] == nullptr) {
+            corrupted = true;
+            return;
+          }
+        }
+        for (std::size_t i = 0; i < kPerThread; ++i) {
+          if (live[i]->owner != t || live[i]->check != round * kPerThread + i) {
+            corrupted = true;
+          }
+          pool.Free(live[i]);
+        }
+      }
+      if constexpr (std::is_same_v<Pool, ConcurrentPool>) {
+        pool.GetFreeList().Flush();
+      }
+    });
+  }
+
+  go.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// enough headroom for every thread's magazine
+constexpr std::size_t kPoolSize =
+    kThreads * (kPerThread + ConcurrentFreeList<Payload>::kMagazineSize);
+}  // namespace
+
+TEST(ConcurrentFreeListTest, EmptyListReturnsNullptr) {
+  constexpr size_t kNumBlocks = 1;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  ConcurrentFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  TestNode* node = freeList.Pop();
+  ASSERT_NE(node, nullptr);
+
+  ASSERT_EQ(freeList.Pop(), nullptr);
+
+  freeList.Push(node);
+
+  TestNode* nextNode = freeList.Pop();
+  ASSERT_EQ(nextNode, node);
+}
+
+TEST(ConcurrentFreeListTest, AllSlotsAreReachable) {
+  constexpr size_t kNumBlocks = 1000;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  ConcurrentFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  std::set<TestNode*> popped;
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    TestNode* node = freeList.Pop();
+    ASSERT_NE(node, nullptr);
+    popped.insert(node);
+  }
+  ASSERT_EQ(popped.size(), kNumBlocks);
+  ASSERT_EQ(freeList.Pop(), nullptr);
+
+  for (auto node : popped) {
+    freeList.Push(node);
+  }
+  freeList.Flush();
+
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    ASSERT_NE(freeList.Pop(), nullptr);
+  }
+  ASSERT_EQ(freeList.Pop(), nullptr);
+}
+
+TEST(ConcurrentFreeListTest, BatchReachesEverySlot) {
+  constexpr size_t kNumBlocks = 1000;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  ConcurrentFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  // some slots sit in the magazine
+  freeList.Push(freeList.Pop());
+
+  std::vector<TestNode*> batch(kNumBlocks + 1);
+  ASSERT_EQ(freeList.PopBatch(batch.data(), batch.size()), kNumBlocks);
+  ASSERT_EQ(std::set(batch.begin(), batch.end() - 1).size(), kNumBlocks);
+
+  freeList.PushBatch(batch.data(), kNumBlocks);
+  ASSERT_EQ(freeList.PopBatch(batch.data(), batch.size()), kNumBlocks);
+}
+
+TEST(ConcurrentFreeListTest, ForeignThreadSeesFlushedSlots) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  ConcurrentFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  std::vector<TestNode*> nodes;
+  std::thread([&] {
+    for (size_t i = 0; i < kNumBlocks; ++i) {
+      nodes.push_back(freeList.Pop());
+    }
+  }).join();
+  ASSERT_EQ(freeList.Pop(), nullptr);
+
+  std::thread([&] {
+    for (auto node : nodes) {
+      freeList.Push(node);
+    }
+    freeList.Flush();
+  }).join();
+
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    ASSERT_NE(freeList.Pop(), nullptr);
+  }
+}
+
+TEST(ConcurrentFreeListTest, HammerAllocateFree) {
+  ConcurrentPool pool(kPoolSize);
+  std::atomic<bool> corrupted{false};
+
+  Hammer(pool, corrupted);
+  ASSERT_FALSE(corrupted);
+
+  // nothing lost, nothing handed out twice
+  std::set<Payload*> all;
+  while (auto ptr = pool.Allocate(0u, 0u)) {
+    ASSERT_TRUE(all.insert(ptr).second);
+  }
+  ASSERT_EQ(all.size(), kPoolSize);
+}
+
+TEST(ConcurrentFreeListTest, HammerMatchesMutexPool) {
+  // timings live in BM_Contended, over thread counts
+  std::atomic<bool> corrupted{false};
+
+  MutexPool mutexPool(kPoolSize);
+  Hammer(mutexPool, corrupted);
+
+  ConcurrentPool concurrentPool(kPoolSize);
+  Hammer(concurrentPool, corrupted);
+
+  ASSERT_FALSE(corrupted);
+}
@@ -80,3 +80,59 @@ TEST(FreeListTest, PopAndPushSingleThread) {
     ASSERT_EQ(rePoppedNodes[i], poppedNodes[kNumBlocks - 1 - i]);
   }
 }
+
+TEST(FreeListTest, ExtendAddsSlots) {
+  constexpr size_t kNumBlocks = 4;
+  std::vector<std::byte> first(kNumBlocks * sizeof(TestNode));
+  std::vector<std::byte> second(kNumBlocks * sizeof(TestNode));
+  FreeList<TestNode> freeList(first.data(), kNumBlocks);
+  freeList.Extend(second.data(), kNumBlocks);
+
+  size_t popped = 0;
+  while (freeList.Pop() != nullptr) {
+    ++popped;
+  }
+  ASSERT_EQ(popped, 2 * kNumBlocks);
+}
+
+TEST(FreeListTest, RemoveIfUnlinksMatchingSlots) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  FreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+  auto const middle = reinterpret_cast<TestNode const*>(buffer.data()) + kNumBlocks / 2;
+
+  freeList.RemoveIf([middle](TestNode const* node) { return node < middle; });
+
+  size_t visited = 0;
+  freeList.ForEach([&](TestNode const* node) {
+    ASSERT_GE(node, middle);
+    ++visited;
+  });
+  ASSERT_EQ(visited, kNumBlocks / 2);
+
+  for (size_t i = 0; i < kNumBlocks / 2; ++i) {
+    ASSERT_GE(freeList.Pop(), middle);
+  }
+  ASSERT_EQ(freeList.Pop(), nullptr);
+}
+
+TEST(FreeListTest, BatchMatchesScalarOrder) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  std::vector<std::byte> reference(kNumBlocks * sizeof(TestNode));
+  FreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+  FreeList<TestNode> scalar(reference.data(), kNumBlocks);
+  auto const offset = reference.data() - buffer.data();
+
+  std::vector<TestNode*> batch(kNumBlocks + 1);
+  ASSERT_EQ(freeList.PopBatch(batch.data(), 4), 4);
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(reinterpret_cast<std::byte*>(batch[i]) + offset,
+              reinterpret_cast<std::byte*>(scalar.Pop()));
+  }
+
+  freeList.PushBatch(batch.data(), 4);
+  ASSERT_EQ(freeList.Pop(), batch[3]);
+  ASSERT_EQ(freeList.PopBatch(batch.data(), batch.size()), kNumBlocks - 1);
+  ASSERT_EQ(freeList.Pop(), nullptr);
+}
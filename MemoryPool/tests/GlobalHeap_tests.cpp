@@ -0,0 +1,131 @@
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../GlobalHeap.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+bool IsAligned(void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+}  // namespace
+
+TEST(GlobalHeapTest, HonoursAlignment) {
+  auto& heap = GlobalHeap::Instance();
+
+  for (std::size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+    for (std::size_t size : {0, 1, 7, 8, 24, 100, 1024, 4000, 200000}) {
+      auto ptr = heap.Allocate(size, alignment);
+      ASSERT_NE(ptr, nullptr);
+      ASSERT_TRUE(IsAligned(ptr, alignment)) << size << ' ' << alignment;
+      std::memset(ptr, 0xAB, size);
+      heap.Deallocate(ptr);
+    }
+  }
+}
+
+TEST(GlobalHeapTest, CountsEveryPath) {
+  auto& heap = GlobalHeap::Instance();
+  auto const before = heap.Counters();
+
+  auto small = heap.Allocate(24, 8);
+  auto medium = heap.Allocate(4000, 16);
+  auto large = heap.Allocate(GlobalHeap::kMmapThreshold, 16);
+  heap.Deallocate(small);
+  heap.Deallocate(medium);
+  heap.Deallocate(large);
+
+  auto const after = heap.Counters();
+  ASSERT_EQ(after.smallAllocations - before.smallAllocations, 1);
+  ASSERT_EQ(after.smallDeallocations - before.smallDeallocations, 1);
+  ASSERT_EQ(after.largeAllocations - before.largeAllocations, 2);
+  ASSERT_EQ(after.largeDeallocations - before.largeDeallocations, 2);
+  ASSERT_EQ(after.mappedAllocations - before.mappedAllocations, 1);
+  ASSERT_GE(after.allocatedBytes - before.allocatedBytes,
+            32 + 4000 + GlobalHeap::kMmapThreshold);
+}
+
+TEST(GlobalHeapTest, ReusesFreedSlots) {
+  auto& heap = GlobalHeap::Instance();
+
+  auto ptr = heap.Allocate(40, 8);
+  heap.Deallocate(ptr);
+  // same class, the thread cache is LIFO
+  ASSERT_EQ(heap.Allocate(48, 16), ptr);
+  heap.Deallocate(ptr);
+}
+
+TEST(GlobalHeapTest, ReportsFailure) {
+  auto& heap = GlobalHeap::Instance();
+  auto const before = heap.Counters();
+
+  ASSERT_EQ(heap.Allocate(SIZE_MAX / 2, 16), nullptr);
+  ASSERT_EQ(heap.Counters().failedAllocations - before.failedAllocations, 1);
+}
+
+TEST(GlobalHeapTest, ManyLiveObjects) {
+  auto& heap = GlobalHeap::Instance();
+
+  std::vector<std::byte*> ptrs;
+  std::set<std::byte*> unique;
+  for (int i = 0; i < 100000; ++i) {
+    auto ptr = static_cast<std::byte*>(heap.Allocate(16, 16));
+    ASSERT_TRUE(unique.insert(ptr).second);
+    *ptr = std::byte(i & 0xFF);
+    ptrs.push_back(ptr);
+  }
+  for (int i = 0; i < 100000; ++i) {
+    ASSERT_EQ(*ptrs[i], std::byte(i & 0xFF));
+    heap.Deallocate(ptrs[i]);
+  }
+}
+
+// blocks freed by another thread and by exiting threads come back
+TEST(GlobalHeapTest, CrossThreadDeallocation) {
+  constexpr int kThreads = 4;
+  constexpr int kBlocks = 10000;
+  auto& heap = GlobalHeap::Instance();
+
+  std::vector<void*> blocks(kThreads * kBlocks);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kBlocks; ++i) {
+        blocks[t * kBlocks + i] = heap.Allocate(64, 64);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  std::set<void*> unique(blocks.begin(), blocks.end());
+  ASSERT_EQ(unique.size(), blocks.size());
+  ASSERT_FALSE(unique.contains(nullptr));
+
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      // reverse order: every thread frees another one's blocks
+      auto const owner = kThreads - 1 - t;
+      for (int i = 0; i < kBlocks; ++i) {
+        heap.Deallocate(blocks[owner * kBlocks + i]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto const before = heap.Counters();
+  for (int i = 0; i < kThreads * kBlocks; ++i) {
+    blocks[i] = heap.Allocate(64, 64);
+  }
+  // flushed caches of dead threads cover everything
+  ASSERT_EQ(heap.Counters().chunksCarved, before.chunksCarved);
+  for (auto ptr : blocks) {
+    heap.Deallocate(ptr);
+  }
+}
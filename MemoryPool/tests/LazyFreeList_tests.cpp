@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "../LazyFreeList.hpp"
+#include "gtest/gtest.h"
+
+struct alignas(alignof(uintptr_t)) TestNode {
+  int value;
+};
+
+TEST(LazyFreeListTest, ConstructionTouchesNothing) {
+  constexpr size_t kNumBlocks = 100;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode), std::byte{0xAB});
+  LazyFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  ASSERT_TRUE(std::ranges::all_of(buffer, [](std::byte b) { return b == std::byte{0xAB}; }));
+  ASSERT_EQ(freeList.Untouched(), kNumBlocks);
+}
+
+TEST(LazyFreeListTest, BumpsInAddressOrder) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  LazyFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  auto const first = reinterpret_cast<TestNode*>(buffer.data());
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    ASSERT_EQ(freeList.Pop(), first + i);
+  }
+  ASSERT_EQ(freeList.Pop(), nullptr);
+  ASSERT_EQ(freeList.Untouched(), 0);
+}
+
+TEST(LazyFreeListTest, RecycledSlotsComeFirst) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  LazyFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  auto a = freeList.Pop();
+  auto b = freeList.Pop();
+  freeList.Push(a);
+  freeList.Push(b);
+
+  ASSERT_EQ(freeList.Pop(), b);
+  ASSERT_EQ(freeList.Pop(), a);
+  ASSERT_EQ(freeList.Untouched(), kNumBlocks - 2);
+}
+
+TEST(LazyFreeListTest, PopAndPushSingleThread) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  LazyFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  std::vector<TestNode*> poppedNodes;
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    TestNode* node = freeList.Pop();
+    ASSERT_NE(node, nullptr);
+    poppedNodes.push_back(node);
+  }
+
+  ASSERT_EQ(freeList.Pop(), nullptr);
+
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    freeList.Push(poppedNodes[i]);
+  }
+
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    ASSERT_EQ(freeList.Pop(), poppedNodes[kNumBlocks - 1 - i]);
+  }
+}
+
+TEST(LazyFreeListTest, ExtendKeepsLeftovers) {
+  constexpr size_t kNumBlocks = 4;
+  std::vector<std::byte> first(kNumBlocks * sizeof(TestNode));
+  std::vector<std::byte> second(kNumBlocks * sizeof(TestNode));
+  LazyFreeList<TestNode> freeList(first.data(), kNumBlocks);
+
+  (void)freeList.Pop();
+  freeList.Extend(second.data(), kNumBlocks);
+
+  std::set<TestNode*> popped;
+  while (auto node = freeList.Pop()) {
+    popped.insert(node);
+  }
+  ASSERT_EQ(popped.size(), 2 * kNumBlocks - 1);
+}
+
+TEST(LazyFreeListTest, ForEachAndRemoveIfSeeBumpRegion) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  LazyFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+  auto const middle = reinterpret_cast<TestNode const*>(buffer.data()) + kNumBlocks / 2;
+
+  freeList.Push(freeList.Pop());
+
+  size_t visited = 0;
+  freeList.ForEach([&](TestNode const*) { ++visited; });
+  ASSERT_EQ(visited, kNumBlocks);
+
+  freeList.RemoveIf([middle](TestNode const* node) { return node < middle; });
+  for (size_t i = 0; i < kNumBlocks / 2; ++i) {
+    ASSERT_GE(freeList.Pop(), middle);
+  }
+  ASSERT_EQ(freeList.Pop(), nullptr);
+}
+
+TEST(LazyFreeListTest, RemoveIfLeavesBumpRegionUnthreaded) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  LazyFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+  auto const first = freeList.Pop();
+  freeList.Push(first);
+
+  // the untouched slots stay in the bump region, not in the list
+  freeList.RemoveIf([first](TestNode const* node) { return node == first; });
+  ASSERT_EQ(freeList.Untouched(), kNumBlocks - 1);
+
+  // all of it goes without being threaded first
+  freeList.RemoveIf([](TestNode const*) { return true; });
+  ASSERT_EQ(freeList.Untouched(), 0);
+  ASSERT_EQ(freeList.Pop(), nullptr);
+}
+
+TEST(LazyFreeListTest, BatchDrainsListThenBumps) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  LazyFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  auto const first = reinterpret_cast<TestNode*>(buffer.data());
+  std::vector<TestNode*> batch(kNumBlocks);
+  ASSERT_EQ(freeList.PopBatch(batch.data(), 3), 3);
+  freeList.PushBatch(batch.data(), 2);
+
+  ASSERT_EQ(freeList.PopBatch(batch.data(), 4), 4);
+  ASSERT_EQ(batch[0], first + 1);
+  ASSERT_EQ(batch[1], first);
+  ASSERT_EQ(batch[2], first + 3);
+  ASSERT_EQ(batch[3], first + 4);
+  ASSERT_EQ(freeList.Untouched(), kNumBlocks - 5);
+
+  ASSERT_EQ(freeList.PopBatch(batch.data(), kNumBlocks), kNumBlocks - 5);
+  ASSERT_EQ(freeList.Pop(), nullptr);
+}
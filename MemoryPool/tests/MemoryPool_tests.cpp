@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <random>
+#include <set>
+#include <stdexcept>
 
 #include "../MemoryPool.hpp"
 #include <gtest/gtest.h>
@@ -143,3 +145,190 @@ TEST_F(MemoryPoolTest, FullSmartAllocation) {
   auto smartPtr = pool.AllocateSmart();
   ASSERT_EQ(smartPtr, nullptr);
 }
+
+// Test case for growth instead of nullptr
+TEST_F(MemoryPoolTest, GrowsWhenExhausted) {
+  constexpr size_t kPoolSize = 4;
+  MemoryPool<TestClass> pool(kPoolSize, GrowthPolicy{});
+
+  std::vector<TestClass*> allocatedPtrs;
+  for (size_t i = 0; i < 10 * kPoolSize; ++i) {
+    auto ptr = pool.Allocate();
+    ASSERT_NE(ptr, nullptr);
+    allocatedPtrs.push_back(ptr);
+  }
+  ASSERT_EQ(TestClass::mInstanceCount, 10 * kPoolSize);
+  // 4 -> 8 -> 16 -> 32 -> 64
+  ASSERT_EQ(pool.Capacity(), 64);
+  ASSERT_EQ(pool.SlabCount(), 5);
+
+  for (auto ptr : allocatedPtrs) {
+    pool.Free(ptr);
+  }
+  ASSERT_EQ(TestClass::mInstanceCount, 0);
+}
+
+// Test case for pointer stability across growth
+TEST_F(MemoryPoolTest, GrowthKeepsPointersStable) {
+  MemoryPool<int64_t> pool(1, GrowthPolicy{.growthFactor = 1.5});
+
+  std::vector<int64_t*> allocatedPtrs;
+  for (int64_t i = 0; i < 1000; ++i) {
+    auto ptr = pool.Allocate(i);
+    ASSERT_NE(ptr, nullptr);
+    allocatedPtrs.push_back(ptr);
+  }
+
+  for (int64_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(*allocatedPtrs[i], i);
+  }
+}
+
+// Test case for growth limits
+TEST_F(MemoryPoolTest, GrowthRespectsLimits) {
+  MemoryPool<TestClass> pool(
+      2, GrowthPolicy{.growthFactor = 10.0, .maxSlabSize = 3, .maxCapacity = 7});
+
+  for (size_t i = 0; i < 7; ++i) {
+    ASSERT_NE(pool.Allocate(), nullptr);
+  }
+  // 2 + 3 + 2
+  ASSERT_EQ(pool.SlabCount(), 3);
+  ASSERT_EQ(pool.Allocate(), nullptr);
+}
+
+// Test case for giving fully free slabs back
+TEST_F(MemoryPoolTest, TrimReleasesFreeSlabs) {
+  constexpr size_t kPoolSize = 8;
+  MemoryPool<TestClass> pool(kPoolSize, GrowthPolicy{});
+
+  std::vector<TestClass*> allocatedPtrs;
+  for (size_t i = 0; i < 4 * kPoolSize; ++i) {
+    allocatedPtrs.push_back(pool.Allocate());
+  }
+  ASSERT_EQ(pool.SlabCount(), 3);
+
+  // nothing is fully free yet
+  ASSERT_EQ(pool.Trim(), 0);
+
+  // keep one object from the initial slab and one from the last slab alive
+  auto const first = allocatedPtrs.front();
+  auto const last = allocatedPtrs.back();
+  for (auto ptr : allocatedPtrs) {
+    if (ptr != first && ptr != last) {
+      pool.Free(ptr);
+    }
+  }
+
+  // the middle 8 slot slab goes, the one holding last stays
+  ASSERT_EQ(pool.Trim(), kPoolSize);
+  ASSERT_EQ(pool.SlabCount(), 2);
+  ASSERT_EQ(pool.Capacity(), 3 * kPoolSize);
+
+  pool.Free(first);
+  pool.Free(last);
+  ASSERT_EQ(pool.Trim(), 2 * kPoolSize);
+  ASSERT_EQ(pool.SlabCount(), 1);
+
+  // every remaining slot is still usable and the pool grows again
+  for (size_t i = 0; i < 2 * kPoolSize; ++i) {
+    ASSERT_NE(pool.Allocate(), nullptr);
+  }
+  ASSERT_EQ(pool.SlabCount(), 2);
+}
+
+// the bump region of a released slab goes with it, unthreaded
+TEST_F(MemoryPoolTest, TrimDropsUntouchedSlotsOfReleasedSlab) {
+  constexpr size_t kPoolSize = 8;
+  MemoryPool<TestClass> pool(kPoolSize, GrowthPolicy{});
+
+  std::vector<TestClass*> allocatedPtrs;
+  for (size_t i = 0; i < kPoolSize + 1; ++i) {
+    allocatedPtrs.push_back(pool.Allocate());
+  }
+  ASSERT_EQ(pool.SlabCount(), 2);
+  ASSERT_EQ(pool.GetFreeList().Untouched(), kPoolSize - 1);
+
+  pool.Free(allocatedPtrs.back());
+  ASSERT_EQ(pool.Trim(), kPoolSize);
+  ASSERT_EQ(pool.GetFreeList().Untouched(), 0);
+
+  // the next allocation grows a new slab instead of bumping into the old one
+  ASSERT_NE(pool.Allocate(), nullptr);
+  ASSERT_EQ(pool.SlabCount(), 2);
+}
+
+namespace {
+struct ThrowingClass {
+  static inline int mInstanceCount = 0;
+  static inline int mThrowAt = -1;
+
+  ThrowingClass() {
+    if (mInstanceCount == mThrowAt) {
+      throw std::runtime_error("ctor");
+    }
+    ++mInstanceCount;
+  }
+
+  ~ThrowingClass() {
+    --mInstanceCount;
+  }
+};
+}  // namespace
+
+TEST_F(MemoryPoolTest, BatchAllocation) {
+  constexpr size_t kPoolSize = 64;
+  MemoryPool<TestClass> pool(kPoolSize);
+
+  std::vector<TestClass*> ptrs(kPoolSize);
+  ASSERT_TRUE(pool.AllocateBatch(ptrs));
+  ASSERT_EQ(TestClass::mInstanceCount, kPoolSize);
+  ASSERT_EQ(std::set(ptrs.begin(), ptrs.end()).size(), kPoolSize);
+  ASSERT_EQ(pool.Allocate(), nullptr);
+
+  pool.FreeBatch(ptrs);
+  ASSERT_EQ(TestClass::mInstanceCount, 0);
+  ASSERT_TRUE(pool.AllocateBatch(ptrs));
+  pool.FreeBatch(ptrs);
+}
+
+TEST_F(MemoryPoolTest, BatchIsAllOrNothing) {
+  constexpr size_t kPoolSize = 5;
+  MemoryPool<TestClass> pool(kPoolSize);
+
+  std::vector<TestClass*> ptrs(kPoolSize + 1);
+  ASSERT_FALSE(pool.AllocateBatch(ptrs));
+  ASSERT_EQ(TestClass::mInstanceCount, 0);
+
+  // every slot went back
+  for (size_t i = 0; i < kPoolSize; ++i) {
+    ASSERT_NE(pool.Allocate(), nullptr);
+  }
+}
+
+TEST_F(MemoryPoolTest, BatchRollsBackPartialConstruction) {
+  constexpr size_t kPoolSize = 8;
+  MemoryPool<ThrowingClass> pool(kPoolSize);
+  ThrowingClass::mInstanceCount = 0;
+  ThrowingClass::mThrowAt = 5;
+
+  std::vector<ThrowingClass*> ptrs(kPoolSize);
+  ASSERT_FALSE(pool.AllocateBatch(ptrs));
+  ASSERT_EQ(ThrowingClass::mInstanceCount, 0);
+
+  ThrowingClass::mThrowAt = -1;
+  ASSERT_TRUE(pool.AllocateBatch(ptrs));
+  ASSERT_EQ(ThrowingClass::mInstanceCount, kPoolSize);
+  pool.FreeBatch(ptrs);
+}
+
+TEST_F(MemoryPoolTest, BatchGrows) {
+  constexpr size_t kPoolSize = 4;
+  MemoryPool<int, FreeList<int>> pool(kPoolSize, GrowthPolicy{});
+
+  std::vector<int*> ptrs(10 * kPoolSize);
+  ASSERT_TRUE(pool.AllocateBatch(std::span{ptrs}, 7));
+  ASSERT_TRUE(std::ranges::all_of(ptrs, [](int* ptr) { return *ptr == 7; }));
+  ASSERT_GE(pool.Capacity(), ptrs.size());
+  pool.FreeBatch(ptrs);
+}
@@ -0,0 +1,135 @@
+#include <cstring>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../GlobalHeap.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+bool IsAligned(void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+struct alignas(128) OverAligned {
+  std::byte bytes[128];
+};
+
+std::uint64_t Allocations() {
+  auto const counters = GlobalHeap::Instance().Counters();
+  return counters.smallAllocations + counters.largeAllocations;
+}
+
+std::uint64_t Deallocations() {
+  auto const counters = GlobalHeap::Instance().Counters();
+  return counters.smallDeallocations + counters.largeDeallocations;
+}
+}  // namespace
+
+TEST(OverrideNewDeleteTest, EveryOverloadGoesThroughHeap) {
+  auto const allocations = Allocations();
+  auto const deallocations = Deallocations();
+
+  for (std::size_t size : {1, 16, 100, 5000, 300000}) {
+    operator delete(operator new(size));
+    operator delete[](operator new[](size));
+    operator delete(operator new(size), size);
+    operator delete[](operator new[](size), size);
+    operator delete(operator new(size, std::nothrow), std::nothrow);
+    operator delete[](operator new[](size, std::nothrow), std::nothrow);
+
+    for (std::size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+      auto const align = std::align_val_t{alignment};
+      auto ptr = operator new(size, align);
+      ASSERT_TRUE(IsAligned(ptr, alignment)) << size << ' ' << alignment;
+      std::memset(ptr, 0xAB, size);
+      operator delete(ptr, align);
+
+      ptr = operator new[](size, align);
+      ASSERT_TRUE(IsAligned(ptr, alignment));
+      operator delete[](ptr, size, align);
+
+      ptr = operator new(size, align, std::nothrow);
+      ASSERT_TRUE(IsAligned(ptr, alignment));
+      operator delete(ptr, size, align);
+
+      ptr = operator new[](size, align, std::nothrow);
+      ASSERT_TRUE(IsAligned(ptr, alignment));
+      operator delete[](ptr, align, std::nothrow);
+    }
+  }
+
+  // 5 sizes * (6 + 13 alignments * 4)
+  ASSERT_GE(Allocations() - allocations, 5 * (6 + 13 * 4));
+  ASSERT_GE(Deallocations() - deallocations, 5 * (6 + 13 * 4));
+}
+
+TEST(OverrideNewDeleteTest, ZeroSizeIsUnique) {
+  auto a = operator new(0);
+  auto b = operator new(0);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(a, b);
+  operator delete(a);
+  operator delete(b);
+}
+
+TEST(OverrideNewDeleteTest, NewExpressions) {
+  auto over = std::make_unique<OverAligned>();
+  ASSERT_TRUE(IsAligned(over.get(), alignof(OverAligned)));
+
+  auto array = std::make_unique<OverAligned[]>(10);
+  ASSERT_TRUE(IsAligned(array.get(), alignof(OverAligned)));
+
+  std::map<int, std::string> map;
+  for (int i = 0; i < 10000; ++i) {
+    map[i] = std::string(i % 100, 'x');
+  }
+  ASSERT_EQ(map[99].size(), 99);
+}
+
+TEST(OverrideNewDeleteTest, Failure) {
+  ASSERT_THROW(
+      { [[maybe_unused]] auto ptr = operator new(SIZE_MAX / 2); }, std::bad_alloc);
+  ASSERT_EQ(operator new(SIZE_MAX / 2, std::nothrow), nullptr);
+  ASSERT_EQ(operator new[](SIZE_MAX / 2, std::align_val_t{64}, std::nothrow), nullptr);
+}
+
+TEST(OverrideNewDeleteTest, CallsNewHandler) {
+  static int calls = 0;
+  calls = 0;
+  std::set_new_handler([] {
+    // gives up on the second try
+    if (++calls == 2) {
+      std::set_new_handler(nullptr);
+    }
+  });
+
+  ASSERT_EQ(operator new(SIZE_MAX / 2, std::nothrow), nullptr);
+  ASSERT_EQ(calls, 2);
+}
+
+TEST(OverrideNewDeleteTest, CrossThreadDelete) {
+  constexpr int kBlocks = 10000;
+  std::vector<std::string*> strings;
+  for (int i = 0; i < kBlocks; ++i) {
+    strings.push_back(new std::string(i % 64, 'y'));
+  }
+
+  std::thread([&] {
+    for (auto s : strings) {
+      delete s;
+    }
+  }).join();
+
+  std::thread([] {
+    std::vector<std::unique_ptr<int>> ints;
+    for (int i = 0; i < kBlocks; ++i) {
+      ints.push_back(std::make_unique<int>(i));
+    }
+    // freed at thread exit, after the cache flush
+    thread_local std::vector<std::unique_ptr<int>> late = std::move(ints);
+  }).join();
+}
@@ -0,0 +1,95 @@
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "../PoolAllocator.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+// SizeClassAllocator that keeps the books
+struct CountingBacking {
+  SizeClassAllocator<> allocator;
+  std::size_t live = 0;
+  std::size_t total = 0;
+
+  void* Allocate(std::size_t size, std::size_t alignment) {
+    ++live;
+    ++total;
+    return allocator.Allocate(size, alignment);
+  }
+
+  void Deallocate(void* ptr, std::size_t size, std::size_t alignment) noexcept {
+    --live;
+    allocator.Deallocate(ptr, size, alignment);
+  }
+};
+
+template <typename T>
+using Counting = PoolAllocator<T, CountingBacking>;
+}  // namespace
+
+TEST(PoolAllocatorTest, RebindsShareBacking) {
+  SizeClassAllocator<> backing;
+  PoolAllocator<int> ints{backing};
+  PoolAllocator<double> doubles{ints};
+
+  ASSERT_EQ(&doubles.GetBacking(), &backing);
+  ASSERT_TRUE(ints == doubles);
+
+  SizeClassAllocator<> other;
+  ASSERT_FALSE(ints == PoolAllocator<int>{other});
+}
+
+TEST(PoolAllocatorTest, AllocateDeallocate) {
+  SizeClassAllocator<> backing;
+  PoolAllocator<std::uint64_t> allocator{backing};
+
+  auto ptr = allocator.allocate(4);
+  for (std::uint64_t i = 0; i < 4; ++i) {
+    ptr[i] = i;
+  }
+  allocator.deallocate(ptr, 4);
+  // LIFO reuse proves the slot went back to the pool
+  ASSERT_EQ(allocator.allocate(4), ptr);
+}
+
+TEST(PoolAllocatorTest, NodeContainersDrawFromPools) {
+  CountingBacking backing;
+  {
+    std::list<int, Counting<int>> list{Counting<int>{backing}};
+    std::map<int, int, std::less<>, Counting<std::pair<int const, int>>> map{
+        Counting<std::pair<int const, int>>{backing}};
+    std::unordered_map<int, int, std::hash<int>, std::equal_to<>,
+                       Counting<std::pair<int const, int>>>
+        hash{Counting<std::pair<int const, int>>{backing}};
+
+    for (int i = 0; i < 1000; ++i) {
+      list.push_back(i);
+      map.emplace(i, i);
+      hash.emplace(i, i);
+    }
+    // a node each plus the bucket arrays
+    ASSERT_GE(backing.live, 3000);
+
+    for (int i = 0; i < 1000; i += 2) {
+      map.erase(i);
+      hash.erase(i);
+    }
+    ASSERT_EQ(map.size(), 500);
+    ASSERT_EQ(hash.at(501), 501);
+  }
+  ASSERT_EQ(backing.live, 0);
+  ASSERT_GE(backing.total, 3000);
+}
+
+TEST(PoolAllocatorTest, Vector) {
+  SizeClassAllocator<> backing;
+  std::vector<int, PoolAllocator<int>> vec{PoolAllocator<int>{backing}};
+
+  // past kMaxSize the backing forwards to operator new
+  for (int i = 0; i < 10000; ++i) {
+    vec.push_back(i);
+  }
+  ASSERT_EQ(vec[9999], 9999);
+}
@@ -0,0 +1,188 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentFreeList.hpp"
+#include "../MemoryPool.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+struct Point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+template <typename T>
+using CheckedPool =
+    MemoryPool<T, LazyFreeList<T, GuardedLayout<>>, NoStats, HeapStorage, DebugChecks>;
+
+struct Pair {
+  std::int64_t first;
+  std::int64_t second;
+};
+
+struct Throwing {
+  explicit Throwing(bool fail) {
+    if (fail) {
+      throw std::runtime_error("rollback");
+    }
+  }
+};
+}  // namespace
+
+TEST(PoolChecksTest, NoChecksIsFree) {
+  static_assert(std::is_empty_v<NoChecks>);
+  static_assert(sizeof(MemoryPool<int>) ==
+                sizeof(MemoryPool<int, LazyFreeList<int>, NoStats, HeapStorage, NoChecks>));
+}
+
+TEST(PoolChecksTest, GuardedLayoutLeavesSlack) {
+  static_assert(GuardedLayout<>::kSize<Point> == 16);
+  static_assert(GuardedLayout<>::kSize<char> == 16);
+  static_assert(GuardedLayout<PaddedLayout>::kSize<Point> == kCacheLineSize);
+}
+
+TEST(PoolChecksTest, CleanUsagePasses) {
+  CheckedPool<Point> pool(8, GrowthPolicy{});
+  std::vector<Point*> points;
+  for (int i = 0; i < 100; ++i) {
+    points.push_back(pool.Allocate(Point{i, -i}));
+  }
+  ASSERT_EQ(pool.GetChecks().Live(), 100);
+  for (auto point : points) {
+    pool.Free(point);
+  }
+  for (int i = 0; i < 100; ++i) {
+    points[i] = pool.Allocate(Point{i, i});
+  }
+  pool.FreeBatch(points);
+  ASSERT_TRUE(pool.AllocateBatch(std::span{points}.first(10), Point{1, 2}));
+  pool.FreeBatch(std::span{points}.first(10));
+  ASSERT_EQ(pool.GetChecks().Live(), 0);
+  ASSERT_GT(pool.Trim(), 0);
+}
+
+TEST(PoolChecksTest, RollbackIsNotALeak) {
+  MemoryPool<Throwing, LazyFreeList<Throwing>, NoStats, HeapStorage, DebugChecks> pool(2);
+  ASSERT_EQ(pool.Allocate(true), nullptr);
+  auto const ok = pool.Allocate(false);
+  ASSERT_NE(ok, nullptr);
+  pool.Free(ok);
+  ASSERT_EQ(pool.GetChecks().Live(), 0);
+}
+
+TEST(PoolChecksTest, ConcurrentUsagePasses) {
+  using Pool = MemoryPool<Point, ConcurrentFreeList<Point, GuardedLayout<>>, NoStats,
+                          HeapStorage, DebugChecks>;
+  Pool pool(1024);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool] {
+      for (int i = 0; i < 10000; ++i) {
+        if (auto point = pool.Allocate(Point{i, i})) {
+          pool.Free(point);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(pool.GetChecks().Live(), 0);
+}
+
+// objects smaller than the link: the link word of a live slot stays
+// readable, lock-free lists may still load it after a racing Pop
+TEST(PoolChecksTest, SmallObjectsLeaveLinkWordUnpoisoned) {
+  using Pool = MemoryPool<std::int16_t, ConcurrentFreeList<std::int16_t, GuardedLayout<>>,
+                          NoStats, HeapStorage, DebugChecks>;
+  Pool pool(1024);
+  auto const value = pool.Allocate(std::int16_t{7});
+  ASSERT_NE(value, nullptr);
+#ifdef MEMORY_POOL_ASAN
+  ASSERT_EQ(__asan_region_is_poisoned(value, DebugChecks::kLinkSize), nullptr);
+#endif
+  pool.Free(value);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool] {
+      for (int i = 0; i < 10000; ++i) {
+        if (auto small = pool.Allocate(static_cast<std::int16_t>(i))) {
+          pool.Free(small);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(pool.GetChecks().Live(), 0);
+}
+
+TEST(PoolChecksTest, ReportsLeaks) {
+  testing::internal::CaptureStderr();
+  {
+    CheckedPool<Point> pool(8);
+    ASSERT_NE(pool.Allocate(Point{1, 2}), nullptr);
+    ASSERT_NE(pool.Allocate(Point{3, 4}), nullptr);
+  }
+  auto const report = testing::internal::GetCapturedStderr();
+  ASSERT_NE(report.find("2 object(s) leaked"), std::string::npos);
+}
+
+using PoolChecksDeathTest = ::testing::Test;
+
+TEST_F(PoolChecksDeathTest, DoubleFree) {
+  CheckedPool<Point> pool(8);
+  auto point = pool.Allocate(Point{1, 2});
+  pool.Free(point);
+  ASSERT_DEATH(pool.Free(point), "double free");
+}
+
+TEST_F(PoolChecksDeathTest, ForeignPointer) {
+  CheckedPool<Point> pool(8);
+  Point outside{};
+  ASSERT_DEATH(pool.Free(&outside), "does not belong to the pool");
+}
+
+TEST_F(PoolChecksDeathTest, InteriorPointer) {
+  CheckedPool<Point> pool(8);
+  auto point = pool.Allocate(Point{1, 2});
+  ASSERT_DEATH(pool.Free(reinterpret_cast<Point*>(&point->y)), "middle of a slot");
+}
+
+// GCC warns about the deliberate out-of-bounds writes below
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#pragma GCC diagnostic ignored "-Wstringop-overflow"
+
+// ASan would stop the bad writes themselves, the checks catch them later
+#ifndef MEMORY_POOL_ASAN
+TEST_F(PoolChecksDeathTest, Overflow) {
+  CheckedPool<Point> pool(8);
+  auto point = pool.Allocate(Point{1, 2});
+  reinterpret_cast<std::byte*>(point)[sizeof(Point)] = std::byte{0};
+  ASSERT_DEATH(pool.Free(point), "overflow");
+}
+
+TEST_F(PoolChecksDeathTest, UseAfterFree) {
+  CheckedPool<Pair> pool(8);
+  auto pair = pool.Allocate(Pair{1, 2});
+  pool.Free(pair);
+  // past the free list link
+  pair->second = 42;
+  ASSERT_DEATH(static_cast<void>(pool.Allocate(Pair{3, 4})), "write to a freed slot");
+}
+#else
+TEST_F(PoolChecksDeathTest, AsanCatchesUseAfterFree) {
+  CheckedPool<Pair> pool(8);
+  auto pair = pool.Allocate(Pair{1, 2});
+  pool.Free(pair);
+  ASSERT_DEATH(reinterpret_cast<std::int64_t volatile&>(pair->second) = 42, "use-after-poison");
+}
+#endif
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,66 @@
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../PoolResource.hpp"
+#include <gtest/gtest.h>
+
+TEST(PoolResourceTest, IsEqualOnlyToItself) {
+  PoolResource<> first;
+  PoolResource<> second;
+
+  ASSERT_TRUE(first.is_equal(first));
+  ASSERT_FALSE(first.is_equal(second));
+  ASSERT_FALSE(first.is_equal(*std::pmr::new_delete_resource()));
+}
+
+TEST(PoolResourceTest, PmrVector) {
+  PoolResource<> resource;
+  std::pmr::vector<int> vec{&resource};
+
+  for (int i = 0; i < 1000; ++i) {
+    vec.push_back(i);
+  }
+  ASSERT_EQ(vec.get_allocator().resource(), &resource);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(vec[i], i);
+  }
+}
+
+TEST(PoolResourceTest, NodeContainers) {
+  PoolResource<> resource;
+  std::pmr::list<int> list{&resource};
+  std::pmr::map<int, std::pmr::string> map{&resource};
+  std::pmr::unordered_map<int, int> hash{&resource};
+
+  for (int i = 0; i < 1000; ++i) {
+    list.push_back(i);
+    map.emplace(i, std::to_string(i) + " is long enough to leave SSO");
+    hash.emplace(i, -i);
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    map.erase(i);
+    hash.erase(i);
+  }
+  list.remove_if([](int v) { return v % 2 == 0; });
+
+  ASSERT_EQ(list.size(), 500);
+  ASSERT_EQ(map.size(), 500);
+  ASSERT_EQ(hash.size(), 500);
+  ASSERT_EQ(map.at(501).get_allocator().resource(), &resource);
+  ASSERT_EQ(hash.at(501), -501);
+}
+
+TEST(PoolResourceTest, UpstreamOfPmrPool) {
+  PoolResource<> resource;
+  std::pmr::unsynchronized_pool_resource pool{&resource};
+  std::pmr::vector<std::pmr::string> strings{&pool};
+
+  for (int i = 0; i < 100; ++i) {
+    strings.emplace_back(std::to_string(i) + " is long enough to leave SSO");
+  }
+  ASSERT_EQ(strings.back().get_allocator().resource(), &pool);
+}
@@ -0,0 +1,75 @@
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "../MemoryPool.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+struct Throwing {
+  explicit Throwing(bool fail) {
+    if (fail) {
+      throw std::runtime_error("rollback");
+    }
+  }
+};
+}  // namespace
+
+TEST(PoolStatsTest, NoStatsIsFree) {
+  static_assert(std::is_empty_v<NoStats>);
+  // the stats member takes no room of its own
+  static_assert(sizeof(MemoryPool<int, LazyFreeList<int>, NoStats>) <
+                sizeof(MemoryPool<int, LazyFreeList<int>, AtomicStats<>>));
+}
+
+TEST(PoolStatsTest, CountsAndHighWater) {
+  MemoryPool<int, LazyFreeList<int>, AtomicStats<>> pool(4);
+
+  std::vector<int*> ptrs;
+  for (int i = 0; i < 4; ++i) {
+    ptrs.push_back(pool.Allocate(i));
+  }
+  ASSERT_EQ(pool.Allocate(4), nullptr);
+  for (auto ptr : ptrs) {
+    pool.Free(ptr);
+  }
+  pool.Free(pool.Allocate(5));
+
+  auto const stats = pool.GetStats().Snapshot();
+  ASSERT_EQ(stats.allocations, 5);
+  ASSERT_EQ(stats.deallocations, 5);
+  ASSERT_EQ(stats.failures, 1);
+  ASSERT_EQ(stats.live, 0);
+  ASSERT_EQ(stats.highWater, 4);
+  // latency disabled
+  ASSERT_EQ(std::accumulate(stats.latency.begin(), stats.latency.end(), 0ull), 0);
+}
+
+TEST(PoolStatsTest, CountsRollbacksAndGrowth) {
+  MemoryPool<Throwing, LazyFreeList<Throwing>, AtomicStats<>> pool(1, GrowthPolicy{});
+
+  ASSERT_EQ(pool.Allocate(true), nullptr);
+  auto a = pool.Allocate(false);
+  auto b = pool.Allocate(false);
+  ASSERT_NE(b, nullptr);
+
+  auto const stats = pool.GetStats().Snapshot();
+  ASSERT_EQ(stats.rollbacks, 1);
+  ASSERT_EQ(stats.failures, 0);
+  ASSERT_EQ(stats.allocations, 2);
+  ASSERT_EQ(stats.growths, 1);
+  ASSERT_EQ(stats.grownSlots, 1);
+  pool.Free(a);
+  pool.Free(b);
+}
+
+TEST(PoolStatsTest, LatencyHistogram) {
+  MemoryPool<int, LazyFreeList<int>, AtomicStats<true>> pool(100);
+
+  for (int i = 0; i < 100; ++i) {
+    pool.Free(pool.Allocate(i));
+  }
+
+  auto const stats = pool.GetStats().Snapshot();
+  ASSERT_EQ(std::accumulate(stats.latency.begin(), stats.latency.end(), 0ull), 100);
+}
@@ -0,0 +1,137 @@
+#include <cstdint>
+#include <vector>
+
+#include "../MemoryPool.hpp"
+#include "../bench/BenchUtils.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+struct Object {
+  std::uint64_t payload[8];
+};
+
+using PagePool = MemoryPool<Object, LazyFreeList<Object>, NoStats, PageStorage>;
+
+PageStorage MakeStorage(PageStorage::Options options) {
+  return PageStorage{options};
+}
+}  // namespace
+
+TEST(PoolStorageTest, HeapStorageKeepsExactCapacity) {
+  MemoryPool<Object> pool(10);
+  ASSERT_EQ(pool.Capacity(), 10);
+}
+
+TEST(PoolStorageTest, SurplusBecomesSlots) {
+  PagePool pool(10, GrowthPolicy::Fixed(),
+                MakeStorage({.hugePages = PageStorage::HugePages::none}));
+
+  auto const page = vm::PageSize();
+  ASSERT_EQ(pool.GetStorage().MappedBytes(), page);
+  ASSERT_EQ(pool.Capacity(), page / sizeof(Object));
+  for (std::size_t i = 0; i < pool.Capacity(); ++i) {
+    ASSERT_NE(pool.Allocate(), nullptr);
+  }
+  ASSERT_EQ(pool.Allocate(), nullptr);
+}
+
+TEST(PoolStorageTest, TransparentHugePagesAreAligned) {
+  PagePool pool(10, GrowthPolicy::Fixed(), MakeStorage({}));
+
+  ASSERT_EQ(pool.GetStorage().MappedBytes(), PageStorage::kHugePageSize);
+  auto const ptr = pool.Allocate();
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % PageStorage::kHugePageSize, 0);
+  ptr->payload[7] = 42;
+  pool.Free(ptr);
+}
+
+// hugetlbfs pool is empty on most boxes, transparent pages take over
+TEST(PoolStorageTest, ReservedHugePagesFallBack) {
+  PagePool pool(10, GrowthPolicy::Fixed(),
+                MakeStorage({.hugePages = PageStorage::HugePages::reserved}));
+
+  auto const& storage = pool.GetStorage();
+  ASSERT_EQ(storage.MappedBytes(), PageStorage::kHugePageSize);
+  ASSERT_TRUE(storage.HugeTlbBytes() == 0 ||
+              storage.HugeTlbBytes() == storage.MappedBytes());
+  std::vector<Object*> ptrs;
+  while (auto ptr = pool.Allocate()) {
+    ptr->payload[0] = ptrs.size();
+    ptrs.push_back(ptr);
+  }
+  ASSERT_EQ(ptrs.size(), PageStorage::kHugePageSize / sizeof(Object));
+}
+
+TEST(PoolStorageTest, NumaBindingDegrades) {
+  PagePool local(10, GrowthPolicy::Fixed(),
+                 MakeStorage({.hugePages = PageStorage::HugePages::none, .numaNode = 0}));
+  // node 0 exists wherever mbind is available at all
+  ASSERT_TRUE(local.GetStorage().BoundBytes() == 0 ||
+              local.GetStorage().BoundBytes() == local.GetStorage().MappedBytes());
+  ASSERT_NE(local.Allocate(), nullptr);
+
+  PagePool nowhere(10, GrowthPolicy::Fixed(),
+                   MakeStorage({.hugePages = PageStorage::HugePages::none, .numaNode = 1000}));
+  ASSERT_EQ(nowhere.GetStorage().BoundBytes(), 0);
+  ASSERT_NE(nowhere.Allocate(), nullptr);
+}
+
+TEST(PoolStorageTest, PrefaultCommitsPages) {
+  constexpr std::size_t kSlots = (8 << 20) / sizeof(Object);
+
+  auto const before = ResidentBytes();
+  PagePool pool(kSlots, GrowthPolicy::Fixed(),
+                MakeStorage({.hugePages = PageStorage::HugePages::none, .prefault = true}));
+  ASSERT_GE(ResidentBytes() - before, pool.GetStorage().MappedBytes() / 2);
+}
+
+TEST(PoolStorageTest, GrowthAndTrimMapAndUnmap) {
+  PagePool pool(1, GrowthPolicy{},
+                MakeStorage({.hugePages = PageStorage::HugePages::none}));
+  auto const page = vm::PageSize();
+  auto const perSlab = page / sizeof(Object);
+
+  std::vector<Object*> ptrs;
+  for (std::size_t i = 0; i < 4 * perSlab; ++i) {
+    ptrs.push_back(pool.Allocate());
+    ASSERT_NE(ptrs.back(), nullptr);
+  }
+  auto const mapped = pool.GetStorage().MappedBytes();
+  ASSERT_GT(mapped, page);
+  ASSERT_EQ(pool.Capacity() * sizeof(Object), mapped);
+
+  for (auto ptr : ptrs) {
+    pool.Free(ptr);
+  }
+  ASSERT_GT(pool.Trim(), 0);
+  ASSERT_EQ(pool.GetStorage().MappedBytes(), page);
+}
+
+TEST(PoolStorageTest, CountersDropOnDeallocate) {
+  PageStorage bound{{.hugePages = PageStorage::HugePages::none, .numaNode = 0}};
+  auto const block = bound.Allocate(1, alignof(Object));
+  ASSERT_TRUE(bound.BoundBytes() == 0 || bound.BoundBytes() == block.size());
+  bound.Deallocate(block, alignof(Object));
+  ASSERT_EQ(bound.MappedBytes(), 0);
+  ASSERT_EQ(bound.BoundBytes(), 0);
+
+  PageStorage reserved{{.hugePages = PageStorage::HugePages::reserved}};
+  auto const first = reserved.Allocate(1, alignof(Object));
+  auto const second = reserved.Allocate(1, alignof(Object));
+  reserved.Deallocate(first, alignof(Object));
+  ASSERT_TRUE(reserved.HugeTlbBytes() == 0 || reserved.HugeTlbBytes() == second.size());
+  reserved.Deallocate(second, alignof(Object));
+  ASSERT_EQ(reserved.MappedBytes(), 0);
+  ASSERT_EQ(reserved.HugeTlbBytes(), 0);
+}
+
+TEST(PoolStorageTest, HonorsAlignmentAboveGranularity) {
+  PageStorage storage{{.hugePages = PageStorage::HugePages::none}};
+  auto const alignment = 16 * vm::PageSize();
+  auto const block = storage.Allocate(1, alignment);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(block.data()) % alignment, 0);
+  ASSERT_EQ(block.size(), vm::PageSize());
+  block[0] = std::byte{1};
+  storage.Deallocate(block, alignment);
+  ASSERT_EQ(storage.MappedBytes(), 0);
+}
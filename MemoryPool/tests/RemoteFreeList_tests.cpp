@@ -0,0 +1,164 @@
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../MemoryPool.hpp"
+#include "../RemoteFreeList.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+struct alignas(alignof(uintptr_t)) TestNode {
+  int value;
+};
+
+struct Message {
+  std::uint64_t sequence;
+  std::uint64_t check;
+};
+
+using MessagePool = MemoryPool<Message, RemoteFreeList<Message>>;
+}  // namespace
+
+TEST(RemoteFreeListTest, OwnerWorksLikeLazyFreeList) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  RemoteFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  auto const first = reinterpret_cast<TestNode*>(buffer.data());
+  auto a = freeList.Pop();
+  auto b = freeList.Pop();
+  ASSERT_EQ(a, first);
+  ASSERT_EQ(b, first + 1);
+
+  freeList.Push(a);
+  ASSERT_EQ(freeList.Pop(), a);
+  ASSERT_EQ(freeList.Untouched(), kNumBlocks - 2);
+}
+
+TEST(RemoteFreeListTest, ForeignFreesAreDrainedBeforeBumping) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  RemoteFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  std::vector<TestNode*> nodes;
+  for (int i = 0; i < 4; ++i) {
+    nodes.push_back(freeList.Pop());
+  }
+  std::thread([&] {
+    ASSERT_FALSE(freeList.IsOwner());
+    for (auto node : nodes) {
+      freeList.Push(node);
+    }
+  }).join();
+
+  std::set<TestNode*> popped;
+  for (int i = 0; i < 4; ++i) {
+    popped.insert(freeList.Pop());
+  }
+  ASSERT_EQ(popped, std::set(nodes.begin(), nodes.end()));
+  ASSERT_EQ(freeList.Untouched(), kNumBlocks - 4);
+}
+
+TEST(RemoteFreeListTest, ForEachSeesRemoteFrees) {
+  constexpr size_t kNumBlocks = 10;
+  std::vector<std::byte> buffer(kNumBlocks * sizeof(TestNode));
+  RemoteFreeList<TestNode> freeList(buffer.data(), kNumBlocks);
+
+  std::vector<TestNode*> nodes(3);
+  ASSERT_EQ(freeList.PopBatch(nodes.data(), nodes.size()), 3);
+  std::thread([&] { freeList.PushBatch(nodes.data(), 2); }).join();
+  freeList.Push(nodes[2]);
+
+  std::size_t free = 0;
+  freeList.ForEach([&](TestNode const*) { ++free; });
+  ASSERT_EQ(free, kNumBlocks);
+
+  freeList.RemoveIf([&](TestNode const* node) { return node == nodes[0]; });
+  free = 0;
+  freeList.ForEach([&](TestNode const*) { ++free; });
+  ASSERT_EQ(free, kNumBlocks - 1);
+}
+
+TEST(RemoteFreeListTest, UniqueHandoffAcrossThreads) {
+  MessagePool pool(4);
+
+  std::vector<MessagePool::Unique> messages;
+  for (std::uint64_t i = 0; i < 4; ++i) {
+    messages.push_back(pool.AllocateSmart(Message{i, ~i}));
+  }
+  ASSERT_EQ(pool.Allocate(), nullptr);
+
+  std::thread([messages = std::move(messages)]() mutable { messages.clear(); }).join();
+
+  // every slot came back through the remote list
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_NE(pool.Allocate(), nullptr);
+  }
+}
+
+// one producer, several consumers freeing concurrently
+TEST(RemoteFreeListTest, PipelineHammer) {
+  constexpr int kConsumers = 3;
+  constexpr int kMessages = 200000;
+  constexpr std::size_t kInFlight = 256;
+  MessagePool pool(kInFlight);
+
+  std::vector<std::atomic<Message*>> mailboxes(kConsumers * kInFlight);
+  std::atomic<bool> done{false};
+  std::atomic<int> corrupted{0};
+
+  std::vector<std::thread> consumers;
+  for (int c = 0; c < kConsumers; ++c) {
+    consumers.emplace_back([&, c] {
+      for (;;) {
+        bool idle = true;
+        for (std::size_t i = c; i < mailboxes.size(); i += kConsumers) {
+          if (auto message = mailboxes[i].exchange(nullptr, std::memory_order_acquire)) {
+            idle = false;
+            if (message->check != ~message->sequence) {
+              corrupted.fetch_add(1, std::memory_order_relaxed);
+            }
+            pool.Free(message);
+          }
+        }
+        if (idle && done.load(std::memory_order_acquire)) {
+          return;
+        }
+        if (idle) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::size_t next = 0;
+  for (std::uint64_t i = 0; i < kMessages; ++i) {
+    Message* message = nullptr;
+    while ((message = pool.Allocate(Message{i, ~i})) == nullptr) {
+      std::this_thread::yield();
+    }
+    // wait for a free mailbox
+    for (;;) {
+      Message* expected = nullptr;
+      next = next + 1 == mailboxes.size() ? 0 : next + 1;
+      if (mailboxes[next].compare_exchange_strong(expected, message,
+                                                  std::memory_order_release)) {
+        break;
+      }
+    }
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  ASSERT_EQ(corrupted.load(), 0);
+  // never grew: capacity was enough only because remote frees came back
+  ASSERT_EQ(pool.Capacity(), kInFlight);
+  std::set<Message*> unique;
+  for (std::size_t i = 0; i < kInFlight; ++i) {
+    ASSERT_TRUE(unique.insert(pool.Allocate()).second);
+  }
+  ASSERT_EQ(pool.Allocate(), nullptr);
+}
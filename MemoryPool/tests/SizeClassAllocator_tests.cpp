@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../SizeClassAllocator.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+bool IsAligned(void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+}  // namespace
+
+TEST(SizeClassAllocatorTest, RoundsUpToSizeClass) {
+  using Allocator = SizeClassAllocator<>;
+  ASSERT_EQ(Allocator::SlotSize(1, 1), 8);
+  ASSERT_EQ(Allocator::SlotSize(8, 8), 8);
+  ASSERT_EQ(Allocator::SlotSize(9, 8), 16);
+  ASSERT_EQ(Allocator::SlotSize(33, 8), 48);
+  ASSERT_EQ(Allocator::SlotSize(1000, 8), 1024);
+  // alignment wins over size
+  ASSERT_EQ(Allocator::SlotSize(1, 32), 32);
+  ASSERT_EQ(Allocator::SlotSize(40, 32), 64);
+  ASSERT_EQ(Allocator::SlotSize(130, 64), 192);
+  // no class fits
+  ASSERT_EQ(Allocator::SlotSize(Allocator::kMaxSize + 1, 8), 0);
+  ASSERT_EQ(Allocator::SlotSize(8, 2 * Allocator::kMaxAlignment), 0);
+}
+
+TEST(SizeClassAllocatorTest, HonoursAlignment) {
+  SizeClassAllocator<> allocator;
+
+  for (std::size_t alignment = 1; alignment <= 256; alignment *= 2) {
+    for (std::size_t size : {1, 7, 8, 24, 100, 500, 1024, 4000}) {
+      auto ptr = allocator.Allocate(size, alignment);
+      ASSERT_NE(ptr, nullptr);
+      ASSERT_TRUE(IsAligned(ptr, alignment)) << size << ' ' << alignment;
+      std::memset(ptr, 0xAB, size);
+      allocator.Deallocate(ptr, size, alignment);
+    }
+  }
+}
+
+TEST(SizeClassAllocatorTest, ReusesFreedSlots) {
+  SizeClassAllocator<> allocator;
+
+  auto ptr = allocator.Allocate(24, 8);
+  allocator.Deallocate(ptr, 24, 8);
+  // same class, LIFO
+  ASSERT_EQ(allocator.Allocate(32, 8), ptr);
+}
+
+TEST(SizeClassAllocatorTest, ManyLiveObjectsGrowPools) {
+  // tiny slabs force growth
+  SizeClassAllocator<> allocator(256);
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<std::size_t> sizes{1, 2000};
+
+  struct Block {
+    std::byte* ptr;
+    std::size_t size;
+  };
+  std::vector<Block> blocks;
+  std::set<std::byte*> unique;
+  for (int i = 0; i < 10000; ++i) {
+    auto const size = sizes(gen);
+    auto ptr = static_cast<std::byte*>(allocator.Allocate(size));
+    ASSERT_TRUE(IsAligned(ptr, alignof(std::max_align_t)));
+    ASSERT_TRUE(unique.insert(ptr).second);
+    std::memset(ptr, i & 0xFF, size);
+    blocks.push_back({ptr, size});
+  }
+
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(blocks[i].ptr[blocks[i].size - 1], std::byte(i & 0xFF));
+  }
+
+  std::ranges::shuffle(blocks, gen);
+  for (auto [ptr, size] : blocks) {
+    allocator.Deallocate(ptr, size);
+  }
+  ASSERT_GT(allocator.Trim(), 0);
+}
+
+// small types no longer need a pointer sized alignment
+TEST(SizeClassAllocatorTest, MemoryPoolOfSmallTypes) {
+  MemoryPool<char> chars(10);
+  MemoryPool<std::int16_t> shorts(10);
+
+  std::set<char*> unique;
+  for (char c = 0; c < 10; ++c) {
+    auto ptr = chars.Allocate(c);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_TRUE(unique.insert(ptr).second);
+    ASSERT_EQ(*ptr, c);
+  }
+  ASSERT_EQ(chars.Allocate('x'), nullptr);
+
+  auto value = shorts.Allocate(std::int16_t{7});
+  ASSERT_EQ(*value, 7);
+  shorts.Free(value);
+}
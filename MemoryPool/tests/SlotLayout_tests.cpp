@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "../ConcurrentFreeList.hpp"
+#include "../FreeList.hpp"
+#include "../LazyFreeList.hpp"
+#include "../MemoryPool.hpp"
+#include "../RemoteFreeList.hpp"
+#include "../SlotLayout.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+struct Counter {
+  std::uint64_t value;
+};
+
+// 64 isn't a multiple of it
+struct Triple {
+  std::uint64_t values[3];
+};
+
+std::uintptr_t Line(void const* ptr) {
+  return reinterpret_cast<std::uintptr_t>(ptr) / kCacheLineSize;
+}
+}  // namespace
+
+TEST(SlotLayoutTest, Sizes) {
+  static_assert(PackedLayout::kSize<Counter> == 8);
+  static_assert(PaddedLayout::kSize<Counter> == kCacheLineSize);
+  static_assert(PaddedLayout::kAlignment<Counter> == kCacheLineSize);
+  static_assert(PaddedLayout::kSize<char[100]> == 2 * kCacheLineSize);
+  static_assert(InterleavedLayout::kSize<Counter> == 8);
+  static_assert(std::is_same_v<SlotLayoutOf<FreeList<int, PaddedLayout>>::Type, PaddedLayout>);
+}
+
+template <typename T>
+void ExpectInterleavedIsAPermutation() {
+  for (std::size_t count : {0, 1, 7, 8, 9, 64, 100, 1000}) {
+    std::set<std::size_t> positions;
+    for (std::size_t i = 0; i < count; ++i) {
+      positions.insert(InterleavedLayout::Position<T>(i, count));
+    }
+    ASSERT_EQ(positions.size(), count);
+    if (count != 0) {
+      ASSERT_EQ(*positions.rbegin(), count - 1);
+    }
+  }
+}
+
+TEST(SlotLayoutTest, InterleavedIsAPermutation) {
+  ExpectInterleavedIsAPermutation<Counter>();
+  ExpectInterleavedIsAPermutation<Triple>();
+  ExpectInterleavedIsAPermutation<char[40]>();
+}
+
+// neighbours start a line plus a slot apart, across column ends too
+TEST(SlotLayoutTest, InterleavedNeighboursAreALineApart) {
+  constexpr auto kSize = InterleavedLayout::kSize<Triple>;
+  static_assert(kSize == 24);
+  for (std::size_t count : {100, 256, 1000}) {
+    for (std::size_t i = 0; i + 1 < count; ++i) {
+      auto const a = InterleavedLayout::Position<Triple>(i, count) * kSize;
+      auto const b = InterleavedLayout::Position<Triple>(i + 1, count) * kSize;
+      ASSERT_GE(a > b ? a - b : b - a, kCacheLineSize + kSize - 1) << count << ' ' << i;
+    }
+  }
+}
+
+TEST(SlotLayoutTest, PaddedSlotsNeverShareALine) {
+  MemoryPool<Counter, LazyFreeList<Counter, PaddedLayout>> pool(16);
+  std::set<std::uintptr_t> lines;
+  for (int i = 0; i < 16; ++i) {
+    auto const ptr = pool.Allocate();
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % kCacheLineSize, 0);
+    ASSERT_TRUE(lines.insert(Line(ptr)).second);
+  }
+}
+
+// no byte of one object on a line of the one handed out before it
+template <typename T, typename List>
+void ExpectConsecutiveOnDifferentLines(std::size_t count) {
+  MemoryPool<T, List> pool(count);
+  auto const lines = [](T const* ptr) {
+    return std::pair{Line(ptr), Line(reinterpret_cast<std::byte const*>(ptr) + sizeof(T) - 1)};
+  };
+  auto previous = lines(pool.Allocate());
+  for (std::size_t i = 1; i < count; ++i) {
+    auto const ptr = pool.Allocate();
+    ASSERT_NE(ptr, nullptr);
+    auto const current = lines(ptr);
+    ASSERT_TRUE(current.first > previous.second || current.second < previous.first) << i;
+    previous = current;
+  }
+}
+
+TEST(SlotLayoutTest, InterleavedSpreadsFreshSlots) {
+  ExpectConsecutiveOnDifferentLines<Counter, FreeList<Counter, InterleavedLayout>>(256);
+  ExpectConsecutiveOnDifferentLines<Counter, LazyFreeList<Counter, InterleavedLayout>>(256);
+  ExpectConsecutiveOnDifferentLines<Counter, RemoteFreeList<Counter, InterleavedLayout>>(256);
+  ExpectConsecutiveOnDifferentLines<Triple, LazyFreeList<Triple, InterleavedLayout>>(256);
+}
+
+TEST(SlotLayoutTest, PoolGrowsWithEveryLayout) {
+  MemoryPool<Counter, ConcurrentFreeList<Counter, PaddedLayout>> padded(4, GrowthPolicy{});
+  MemoryPool<Counter, LazyFreeList<Counter, InterleavedLayout>> interleaved(4, GrowthPolicy{});
+  std::set<Counter*> seen;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(seen.insert(padded.Allocate()).second);
+    ASSERT_TRUE(seen.insert(interleaved.Allocate()).second);
+  }
+  ASSERT_GE(padded.Capacity(), 100);
+}
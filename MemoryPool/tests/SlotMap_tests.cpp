@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../PoolAllocator.hpp"
+#include "../SlotMap.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+struct Entity {
+  int id;
+  std::string name;
+};
+
+template <typename Handle>
+class SlotMapTest : public ::testing::Test {};
+
+using Handles = ::testing::Types<SlotHandle32, SlotHandle64>;
+TYPED_TEST_SUITE(SlotMapTest, Handles);
+}  // namespace
+
+TEST(SlotHandleTest, PacksIntoOneWord) {
+  static_assert(sizeof(SlotHandle32) == 4);
+  static_assert(sizeof(SlotHandle64) == 8);
+
+  auto const handle = SlotHandle32::Make(12345, 67);
+  ASSERT_EQ(handle.Index(), 12345);
+  ASSERT_EQ(handle.Generation(), 67);
+  ASSERT_EQ(SlotHandle32::kMaxGeneration, 4095);
+}
+
+TYPED_TEST(SlotMapTest, InsertGetErase) {
+  SlotMap<Entity, TypeParam> map;
+  auto const a = map.Insert(1, "a");
+  auto const b = map.Insert(2, "b");
+  ASSERT_EQ(map.Size(), 2);
+  ASSERT_EQ(map.Get(a)->name, "a");
+  ASSERT_EQ(map.Get(b)->id, 2);
+
+  ASSERT_TRUE(map.Erase(a));
+  ASSERT_FALSE(map.Contains(a));
+  ASSERT_EQ(map.Get(a), nullptr);
+  ASSERT_FALSE(map.Erase(a));
+  // b moved into the hole, its handle still finds it
+  ASSERT_EQ(map.Get(b)->name, "b");
+  ASSERT_EQ(map.Values().data(), map.Get(b));
+}
+
+TYPED_TEST(SlotMapTest, StaleHandleAfterReuse) {
+  SlotMap<int, TypeParam> map;
+  auto const old = map.Insert(1);
+  map.Erase(old);
+  auto const reused = map.Insert(2);
+
+  ASSERT_EQ(reused.Index(), old.Index());
+  ASSERT_NE(reused.Generation(), old.Generation());
+  ASSERT_EQ(map.Get(old), nullptr);
+  ASSERT_EQ(*map.Get(reused), 2);
+  ASSERT_FALSE(map.Contains(TypeParam{}));
+}
+
+TYPED_TEST(SlotMapTest, ValuesStayDense) {
+  SlotMap<int, TypeParam> map;
+  std::vector<TypeParam> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.push_back(map.Insert(i));
+  }
+  for (int i = 0; i < 100; i += 3) {
+    map.Erase(handles[i]);
+  }
+
+  ASSERT_EQ(map.Size(), 66);
+  auto const values = map.Values();
+  ASSERT_EQ(std::accumulate(values.begin(), values.end(), 0),
+            100 * 99 / 2 - (0 + 99) * 34 / 2);
+  for (std::size_t i = 0; i < map.Size(); ++i) {
+    ASSERT_EQ(map.Get(map.HandleAt(i)), &values[i]);
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(map.Contains(handles[i]), i % 3 != 0);
+  }
+}
+
+TYPED_TEST(SlotMapTest, ClearInvalidatesEverything) {
+  SlotMap<int, TypeParam> map;
+  auto const a = map.Insert(1);
+  auto const b = map.Insert(2);
+  map.Clear();
+  ASSERT_TRUE(map.Empty());
+  ASSERT_FALSE(map.Contains(a));
+  ASSERT_FALSE(map.Contains(b));
+  map.Insert(3);
+  map.Insert(4);
+  ASSERT_FALSE(map.Contains(a));
+  ASSERT_FALSE(map.Contains(b));
+}
+
+TEST(SlotMapTest, GenerationWraps) {
+  SlotMap<int, SlotHandle32> map;
+  auto first = map.Insert(0);
+  auto handle = first;
+  for (std::uint32_t i = 0; i < SlotHandle32::kMaxGeneration; ++i) {
+    map.Erase(handle);
+    handle = map.Insert(0);
+    ASSERT_NE(handle.Generation(), 0);
+  }
+  // wrapped around to the first generation, the documented aliasing
+  ASSERT_EQ(handle, first);
+}
+
+TEST(SlotMapTest, RunsOutOfIndices) {
+  SlotMap<char, SlotHandle<std::uint16_t, 4>> map;
+  for (int i = 0; i < 16; ++i) {
+    map.Insert('x');
+  }
+  ASSERT_THROW(map.Insert('y'), std::length_error);
+  ASSERT_EQ(map.Size(), 16);
+  map.Erase(map.HandleAt(3));
+  ASSERT_NO_THROW(map.Insert('z'));
+}
+
+TEST(SlotMapTest, PoolAllocator) {
+  SizeClassAllocator<> backing;
+  PoolAllocator<Entity> allocator(backing);
+  SlotMap<Entity, SlotHandle32, PoolAllocator<Entity>> map(allocator);
+
+  std::vector<SlotHandle32> handles;
+  for (int i = 0; i < 1000; ++i) {
+    handles.push_back(map.Insert(i, std::to_string(i)));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    map.Erase(handles[i]);
+  }
+  ASSERT_EQ(map.Get(handles[501])->name, "501");
+  ASSERT_EQ(map.Size(), 500);
+}
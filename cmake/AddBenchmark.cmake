@@ -0,0 +1,3 @@
+function(add_benchmark name)
+    target_link_libraries(${name} PRIVATE benchmark::benchmark_main)
+endfunction()